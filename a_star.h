@@ -0,0 +1,258 @@
+#ifndef A_STAR_HPP
+#define A_STAR_HPP
+
+// Goal-directed point-to-point search. A* is Dijkstra with the heap ordered by distance(v) + h(v), where h(v) is
+// a lower bound of the remaining distance from v to end. Dijkstra grows a disk around start, A* stretches it towards end:
+//
+//     Dijkstra:   ( ( ( start ) ) )   end          A*:   start ====> end
+//
+// The heuristic is a template parameter with unsigned int operator()(uint32_t v) const, built for one end.
+// It must be consistent, h(u) <= weight(u, v) + h(v), then every vertex is settled once and the result is exact.
+//   Euclidean_Heuristic - straight-line distance between vertex coordinates (positions as in the visualizer), times
+//                         scale, for graphs where no edge is shorter than scale * length of the segment.
+//   ALT_Heuristic       - A*, Landmarks, Triangle inequality. Exact distances to and from a few landmarks L give
+//                         d(v, end) >= d(L, end) - d(L, v) and d(v, end) >= d(v, L) - d(end, L), the best bound is taken.
+//                         Works on any graph with non-negative weights, no coordinates needed.
+//
+// Landmarks are computed by one Dijkstra from and one to every landmark, run in parallel on a Thread_Pool.
+// Distances are stored vertex-major (all landmarks of a vertex next to each other, one cache line per evaluation)
+// and can be written to a file with save() and read back with Landmarks::load() instead of being recomputed.
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "csr_graph.h"
+#include "priority_queue.h"
+#include "shortest_paths.h"
+#include "thread_pool.h"
+#include "traversal_workspace.h"
+
+// Weights must be non-negative, the heuristic consistent. Stops when end is settled, the path is extract_path(workspace, end).
+// Returns the number of settled vertices.
+template <typename Heuristic, typename Heap = Priority_Queue<Heap_Entry>>
+uint64_t a_star(const CSR_Graph& graph, uint32_t start, uint32_t end, const Heuristic& heuristic, Traversal_Workspace& workspace)
+{
+    workspace.begin(graph.vertex_count());
+    workspace.visit(start);
+    workspace.set_distance(start, 0);
+
+    Heap min_heap;
+    min_heap.insert(Heap_Entry{int(start), heuristic(start)}); // Keyed by distance + heuristic.
+    uint64_t settled = 0;
+
+    while (!min_heap.is_empty())
+    {
+        Heap_Entry current = min_heap.min_peek();
+        min_heap.extract_peek();
+
+        uint32_t u = current.vertex_id;
+        if (workspace.is_finished(u)) { continue; }
+        workspace.finish(u);
+        settled++;
+        if (u == end) { break; }
+
+        for (uint64_t edge = graph.first_edge(u); edge < graph.last_edge(u); ++edge)
+        {
+            uint32_t v = graph.target(edge);
+            unsigned int candidate = workspace.distance(u) + graph.weight(edge);
+
+            if (!workspace.is_visited(v)) { workspace.visit(v); }
+            if (candidate < workspace.distance(v))
+            {
+                workspace.set_distance(v, candidate);
+                workspace.set_parent(v, u);
+                min_heap.insert(Heap_Entry{int(v), candidate + heuristic(v)});
+            }
+        }
+    }
+    return settled;
+}
+
+struct Point {
+    public:
+    double x;
+    double y;
+};
+
+class Euclidean_Heuristic
+{
+    private:
+    const std::vector<Point>& points;
+    Point target;
+    double scale;
+
+    public:
+    Euclidean_Heuristic(const std::vector<Point>& points_, uint32_t end, double scale_ = 1.0)
+        : points(points_), target(points_[end]), scale(scale_) {}
+
+    // Rounded down: stays a consistent lower bound with integer weights.
+    unsigned int operator()(uint32_t v) const
+    {
+        return unsigned(std::floor(scale * std::hypot(points[v].x - target.x, points[v].y - target.y)));
+    }
+};
+
+class Landmarks
+{
+    public:
+    static constexpr unsigned int INF = Traversal_Workspace::INF;
+
+    private:
+    uint32_t V = 0;
+    std::vector<uint32_t> landmark_vertices;
+    std::vector<unsigned int> from_landmark; // [v * count + i] = d(landmark i, v)
+    std::vector<unsigned int> to_landmark;   // [v * count + i] = d(v, landmark i)
+
+    static constexpr uint32_t file_magic = 0x31544c41; // "ALT1"
+
+    public:
+    Landmarks() = default;
+
+    // reversed must be graph.reversed() (the graph itself for undirected graphs).
+    Landmarks(const CSR_Graph& graph, const CSR_Graph& reversed, const std::vector<uint32_t>& landmarks, Thread_Pool& pool)
+        : V(graph.vertex_count()), landmark_vertices(landmarks),
+          from_landmark(uint64_t(graph.vertex_count()) * landmarks.size(), INF),
+          to_landmark(uint64_t(graph.vertex_count()) * landmarks.size(), INF)
+    {
+        std::vector<Traversal_Workspace> workspaces(pool.size());
+        const uint64_t count = landmarks.size();
+        pool.parallel_for(0, 2 * count, [&](uint64_t search, int thread_index) {
+            bool forward = search < count;
+            uint64_t i = search % count;
+            Traversal_Workspace& workspace = workspaces[thread_index];
+            dijkstra(forward ? graph : reversed, landmarks[i], workspace);
+            std::vector<unsigned int>& distances = forward ? from_landmark : to_landmark;
+            for (uint32_t v : workspace.touched()) { distances[v * count + i] = workspace.distance(v); }
+        }, 1);
+    }
+
+    // Greedy farthest selection: the first landmark is the vertex farthest from start, every next one the vertex
+    // farthest from all landmarks chosen so far. Landmarks behind the targets, on the border of the graph, give the best bounds.
+    static std::vector<uint32_t> farthest(const CSR_Graph& graph, uint32_t count, uint32_t start = 0)
+    {
+        std::vector<uint32_t> landmarks;
+        std::vector<unsigned int> distances(graph.vertex_count(), INF);
+        std::vector<uint32_t> sources{start};
+        while (landmarks.size() < count && landmarks.size() < graph.vertex_count())
+        {
+            // Multi-source Dijkstra, distances[] keeps the distance to the closest source over all rounds.
+            Priority_Queue<Heap_Entry> min_heap;
+            for (uint32_t source : sources) { distances[source] = 0; min_heap.insert(Heap_Entry{int(source), 0}); }
+            while (!min_heap.is_empty())
+            {
+                Heap_Entry current = min_heap.min_peek();
+                min_heap.extract_peek();
+                if (current.distance > distances[current.vertex_id]) { continue; }
+                for (uint64_t edge = graph.first_edge(current.vertex_id); edge < graph.last_edge(current.vertex_id); ++edge)
+                {
+                    unsigned int candidate = current.distance + graph.weight(edge);
+                    if (candidate < distances[graph.target(edge)])
+                    {
+                        distances[graph.target(edge)] = candidate;
+                        min_heap.insert(Heap_Entry{int(graph.target(edge)), candidate});
+                    }
+                }
+            }
+
+            uint32_t farthest_vertex = start;
+            for (uint32_t v = 0; v < graph.vertex_count(); v++)
+            {
+                // Unreachable vertices first: a landmark in every component.
+                if (distances[v] > distances[farthest_vertex] || distances[farthest_vertex] == 0) { farthest_vertex = v; }
+            }
+            if (distances[farthest_vertex] == 0) { break; }
+            landmarks.push_back(farthest_vertex);
+            sources.assign(1, farthest_vertex);
+        }
+        return landmarks;
+    }
+
+    uint32_t vertex_count() const { return V; }
+    uint32_t landmark_count() const { return uint32_t(landmark_vertices.size()); }
+    const std::vector<uint32_t>& landmarks() const { return landmark_vertices; }
+    const unsigned int* from(uint32_t v) const { return from_landmark.data() + uint64_t(v) * landmark_vertices.size(); }
+    const unsigned int* to(uint32_t v) const { return to_landmark.data() + uint64_t(v) * landmark_vertices.size(); }
+
+    uint64_t memory_bytes() const { return (from_landmark.size() + to_landmark.size()) * sizeof(unsigned int); }
+
+    // Format: magic, vertex count, landmark count, landmark ids, then both distance arrays as they are in memory.
+    void save(const std::string& filename) const
+    {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file) { throw std::runtime_error("Cannot open " + filename); }
+        uint32_t header[3] = {file_magic, V, landmark_count()};
+        file.write(reinterpret_cast<const char*>(header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(landmark_vertices.data()), landmark_vertices.size() * sizeof(uint32_t));
+        file.write(reinterpret_cast<const char*>(from_landmark.data()), from_landmark.size() * sizeof(unsigned int));
+        file.write(reinterpret_cast<const char*>(to_landmark.data()), to_landmark.size() * sizeof(unsigned int));
+        if (!file) { throw std::runtime_error("Cannot write " + filename); }
+    }
+
+    // vertices - vertex count of the graph the landmarks are used with; a file made for another graph is rejected.
+    static Landmarks load(const std::string& filename, uint32_t vertices)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file) { throw std::runtime_error("Cannot open " + filename); }
+        uint32_t header[3];
+        file.read(reinterpret_cast<char*>(header), sizeof(header));
+        if (!file || header[0] != file_magic) { throw std::runtime_error(filename + " is not a landmark file"); }
+        if (header[2] == 0) { throw std::runtime_error(filename + " has no landmarks"); }
+        if (header[1] != vertices)
+        {
+            throw std::runtime_error(filename + " is for a graph with " + std::to_string(header[1]) + " vertices, not " + std::to_string(vertices));
+        }
+
+        Landmarks result;
+        result.V = header[1];
+        result.landmark_vertices.resize(header[2]);
+        result.from_landmark.resize(uint64_t(header[1]) * header[2]);
+        result.to_landmark.resize(uint64_t(header[1]) * header[2]);
+        file.read(reinterpret_cast<char*>(result.landmark_vertices.data()), result.landmark_vertices.size() * sizeof(uint32_t));
+        file.read(reinterpret_cast<char*>(result.from_landmark.data()), result.from_landmark.size() * sizeof(unsigned int));
+        file.read(reinterpret_cast<char*>(result.to_landmark.data()), result.to_landmark.size() * sizeof(unsigned int));
+        if (!file) { throw std::runtime_error(filename + " is truncated"); }
+        for (uint32_t v : result.landmark_vertices)
+        {
+            if (v >= vertices) { throw std::runtime_error(filename + " is corrupted"); }
+        }
+        return result;
+    }
+};
+
+class ALT_Heuristic
+{
+    private:
+    const Landmarks& landmarks;
+    std::vector<unsigned int> target_from; // d(landmark, end)
+    std::vector<unsigned int> target_to;   // d(end, landmark)
+
+    public:
+    ALT_Heuristic(const Landmarks& landmarks_, uint32_t end)
+        : landmarks(landmarks_), target_from(landmarks_.from(end), landmarks_.from(end) + landmarks_.landmark_count()),
+          target_to(landmarks_.to(end), landmarks_.to(end) + landmarks_.landmark_count()) {}
+
+    // A bound is skipped when one of its distances is INF (the landmark does not reach or is not reached).
+    unsigned int operator()(uint32_t v) const
+    {
+        const unsigned int* from = landmarks.from(v);
+        const unsigned int* to = landmarks.to(v);
+        unsigned int bound = 0;
+        for (uint32_t i = 0; i < landmarks.landmark_count(); i++)
+        {
+            if (target_from[i] != Landmarks::INF && from[i] != Landmarks::INF && target_from[i] > from[i])
+            {
+                bound = std::max(bound, target_from[i] - from[i]);
+            }
+            if (to[i] != Landmarks::INF && target_to[i] != Landmarks::INF && to[i] > target_to[i])
+            {
+                bound = std::max(bound, to[i] - target_to[i]);
+            }
+        }
+        return bound;
+    }
+};
+
+#endif // A_STAR_HPP
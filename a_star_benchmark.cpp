@@ -0,0 +1,107 @@
+// Point-to-point queries on a geometric road-like graph: vertices on a jittered grid with coordinates, edges to the right
+// and lower neighbour, weight = length of the segment times a random detour factor 1.0 .. 1.5 (never shorter than the segment).
+// Compares Dijkstra which stops at end, A* with the Euclidean heuristic and ALT with landmarks: average settled vertices
+// per query and time. Distances are checked against Dijkstra; the landmarks are saved, loaded back and checked again.
+// Usage: ./a_star_benchmark [width] [height] [queries] [landmarks]
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include "csr_graph.h"
+#include "shortest_paths.h"
+#include "a_star.h"
+#include "thread_pool.h"
+#include "timing.h"
+#include "traversal_workspace.h"
+
+int main(int argc, char* argv[])
+{
+    uint32_t width = argc > 1 ? std::atoi(argv[1]) : 500;
+    uint32_t height = argc > 2 ? std::atoi(argv[2]) : 500;
+    int queries = argc > 3 ? std::atoi(argv[3]) : 100;
+    uint32_t landmark_count = argc > 4 ? std::atoi(argv[4]) : 16;
+    uint32_t vertices = width * height;
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> jitter(-0.3, 0.3), detour(1.0, 1.5);
+    std::vector<Point> points(vertices);
+    for (uint32_t v = 0; v < vertices; v++) { points[v] = Point{10.0 * (v % width + jitter(rng)), 10.0 * (v / width + jitter(rng))}; }
+
+    std::vector<CSR_Edge> edges;
+    auto link = [&](uint32_t u, uint32_t v) {
+        double length = std::hypot(points[u].x - points[v].x, points[u].y - points[v].y);
+        edges.emplace_back(u, v, int32_t(std::ceil(length * detour(rng))));
+    };
+    for (uint32_t v = 0; v < vertices; v++)
+    {
+        if (v % width + 1 < width) { link(v, v + 1); }
+        if (v + width < vertices) { link(v, v + width); }
+    }
+    CSR_Graph graph = CSR_Graph::from_edges(vertices, edges, true);
+    std::cout << "Vertices: " << vertices << "\tDirected edges: " << graph.edge_count() << std::endl;
+
+    std::vector<std::pair<uint32_t, uint32_t>> pairs(queries);
+    for (auto& pair : pairs) { pair = {rng() % vertices, rng() % vertices}; }
+
+    Traversal_Workspace workspace;
+    std::vector<unsigned int> expected(queries);
+    uint64_t settled = 0;
+    double seconds = measure([&]() {
+        for (int i = 0; i < queries; i++)
+        {
+            settled += dijkstra(graph, pairs[i].first, workspace, pairs[i].second);
+            expected[i] = workspace.distance(pairs[i].second);
+        }
+    });
+    double baseline = settled / double(queries);
+    std::cout << "Dijkstra, stop at end:\t" << seconds / queries * 1e3 << " ms/query\tsettled: " << baseline << std::endl;
+
+    auto report = [&](const char* name, double seconds, uint64_t settled, bool correct) {
+        std::cout << name << seconds / queries * 1e3 << " ms/query\tsettled: " << settled / double(queries)
+                  << "\treduction: " << baseline / (settled / double(queries)) << "x" << (correct ? "" : "\tMISMATCH") << std::endl;
+    };
+
+    settled = 0;
+    bool correct = true;
+    seconds = measure([&]() {
+        for (int i = 0; i < queries; i++)
+        {
+            settled += a_star(graph, pairs[i].first, pairs[i].second, Euclidean_Heuristic(points, pairs[i].second), workspace);
+            correct &= workspace.distance(pairs[i].second) == expected[i];
+        }
+    });
+    report("A*, Euclidean:\t\t", seconds, settled, correct);
+
+    Thread_Pool pool;
+    Landmarks landmarks;
+    seconds = measure([&]() { landmarks = Landmarks(graph, graph, Landmarks::farthest(graph, landmark_count), pool); });
+    std::cout << "Landmarks: " << landmarks.landmark_count() << "\tpreprocessing: " << seconds << " s\t"
+              << landmarks.memory_bytes() / (1 << 20) << " MiB\tthreads: " << pool.size() << std::endl;
+
+    auto run_alt = [&](const Landmarks& landmarks, const char* name) {
+        uint64_t settled = 0;
+        bool correct = true;
+        double seconds = measure([&]() {
+            for (int i = 0; i < queries; i++)
+            {
+                settled += a_star(graph, pairs[i].first, pairs[i].second, ALT_Heuristic(landmarks, pairs[i].second), workspace);
+                correct &= workspace.distance(pairs[i].second) == expected[i];
+            }
+        });
+        report(name, seconds, settled, correct);
+    };
+    run_alt(landmarks, "ALT:\t\t\t");
+
+    const char* filename = "landmarks.alt";
+    landmarks.save(filename);
+    Landmarks loaded;
+    seconds = measure([&]() { loaded = Landmarks::load(filename, graph.vertex_count()); });
+    std::cout << "Loaded from " << filename << " in " << seconds << " s" << std::endl;
+    run_alt(loaded, "ALT, loaded:\t\t");
+    std::remove(filename);
+
+    return 0;
+}
@@ -13,6 +13,8 @@
 #include <iostream>
 #include <vector>
 #include <queue>
+#include "csr_graph.h"
+#include "bfs.h"
 
 struct Graph
 {
@@ -60,24 +62,40 @@ struct Graph
     }
 };
 
-
 int main()
 {
     Graph graph{11}; // From 0 to 10 inclusively
 
-    graph.make_bind(0,1);
-    graph.make_bind(0,2);
-    graph.make_bind(1,3);
-    graph.make_bind(1,4);
-    graph.make_bind(2,5);
-    graph.make_bind(2,6);
-    graph.make_bind(3,7);
-    graph.make_bind(4,8);
-    graph.make_bind(5,9);
-    graph.make_bind(6,10);
+    std::vector<CSR_Edge> binds = {{0,1},{0,2},{1,3},{1,4},{2,5},{2,6},{3,7},{4,8},{5,9},{6,10}};
+    for (const auto& bind : binds)
+    {
+        graph.make_bind(bind.vertex_from,bind.vertex_to);
+    }
  
     graph.breadth_first_search(0);
 
+    // The same search on the shared CSR representation. Workspace is reused by every following query without clearing.
+    CSR_Graph csr_graph = CSR_Graph::from_edges(11,binds,true,false);
+    Traversal_Workspace workspace;
+    breadth_first_search(csr_graph,0,workspace);
+    for (uint32_t v : workspace.touched()) { std::cout << v << '\t'; }
+    std::cout << std::endl;
+
+    // Small-radius query: only vertices within 1 hop are touched.
+    breadth_first_search(csr_graph,2,workspace,1);
+    std::cout << "Friends of 2:\t";
+    for (uint32_t v : workspace.touched()) { if (v != 2) std::cout << v << '\t'; }
+    std::cout << std::endl;
+
+    // "You might know them": friends of friends are exactly the vertices on depth 2.
+    BFS_Result result = direction_optimizing_bfs(csr_graph,csr_graph,0);
+    std::cout << "Friends of friends of 0:\t";
+    for (uint32_t v = 0; v < csr_graph.vertex_count(); v++)
+    {
+        if (result.depths[v] == 2) { std::cout << v << '\t'; }
+    }
+    std::cout << std::endl;
+
 
     //          0
     //       /      \
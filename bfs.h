@@ -0,0 +1,369 @@
+#ifndef BFS_HPP
+#define BFS_HPP
+
+// BFS engines over CSR_Graph. Unlike Graph::breadth_first_search in bfs.cpp they do not print anything:
+// the result is the BFS tree (parent of every vertex) and the depth (level) of every vertex, -1 for unreachable ones.
+//
+// Direction-optimizing BFS (Beamer et al.).
+// Top-down step: every vertex of the frontier scans its edges looking for unvisited neighbours. Cheap while the frontier is small.
+// Bottom-up step: every unvisited vertex scans its edges looking for a parent inside the frontier and stops at the first one.
+// On low-diameter graphs (social networks: "friends of friends") the middle levels contain most of the graph;
+// there almost every unvisited vertex finds a parent after a couple of edges, so bottom-up inspects far fewer edges.
+//
+//   level:        0      1       2        3       4
+//   frontier:     .      ..    ......  ........   ..
+//   step:         TD     TD      BU       BU      TD
+//
+// Switch TD -> BU when edges to check from the frontier m_f > m_u / alpha (m_u - edges of unvisited vertices),
+// switch BU -> TD when the frontier shrinks: n_f < n / beta. The bottom-up frontier is a Bitmap.
+//
+// Parallel level-synchronous BFS.
+// Vertices of the current frontier are split between the threads of a Thread_Pool. A neighbour is claimed by an atomic
+// test-and-set on the visited Bitmap, only the winning thread writes its parent and appends it to a thread-local buffer.
+// At the end of the level the buffers are concatenated into the next frontier.
+// Which thread wins a race differs from run to run. With deterministic = true the visited bits of the current level are
+// not touched until the level ends, the parent of a vertex is the smallest id among its frontier neighbours (atomic min)
+// and the next frontier is sorted, hence parents and frontiers are the same for every number of threads and every run.
+//
+// Multi-source BFS (MS-BFS, Then et al.) answers a batch of "distance from X" queries with one traversal.
+// Every vertex holds a bitset with one bit per source: seen[v] - sources which already reached v, visit[v] - sources
+// for which v is on the current frontier. One scan of the edges of v serves all of its sources at once:
+//     next[u] |= visit[v] & ~seen[u]
+// Sources which walk through the same part of the graph share the edge scans, so 64 (uint64_t) or 256 (4 words)
+// queries cost little more than a single BFS.
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "csr_graph.h"
+#include "bitmap.h"
+#include "thread_pool.h"
+#include "traversal_workspace.h"
+
+struct BFS_Result
+{
+    public:
+    std::vector<int> parents;
+    std::vector<int> depths;
+    uint64_t edges_inspected = 0;
+    int top_down_steps = 0;
+    int bottom_up_steps = 0;
+};
+
+// Classic queue-driven BFS, kept as a reference and as the top-down step. Graph is CSR_Graph or Compressed_Graph.
+template <typename Graph>
+BFS_Result top_down_bfs(const Graph& graph, uint32_t source)
+{
+    BFS_Result result;
+    result.parents.assign(graph.vertex_count(), -1);
+    result.depths.assign(graph.vertex_count(), -1);
+    result.parents[source] = source;
+    result.depths[source] = 0;
+
+    std::vector<uint32_t> frontier{source};
+    std::vector<uint32_t> next;
+    for (int depth = 1; !frontier.empty(); depth++)
+    {
+        for (uint32_t u : frontier)
+        {
+            for (uint32_t v : graph.neighbours(u))
+            {
+                result.edges_inspected++;
+                if (result.parents[v] == -1)
+                {
+                    result.parents[v] = u;
+                    result.depths[v] = depth;
+                    next.push_back(v);
+                }
+            }
+        }
+        result.top_down_steps++;
+        frontier.swap(next);
+        next.clear();
+    }
+    return result;
+}
+
+// Queue-driven BFS which keeps its state in a reusable workspace: distance(v) is the depth, parent(v) the BFS tree,
+// touched() lists reached vertices in BFS order. max_depth >= 0 stops the search after that many levels,
+// so a small-radius query costs only the vertices it reaches.
+template <typename Graph>
+void breadth_first_search(const Graph& graph, uint32_t source, Traversal_Workspace& workspace, int max_depth = -1)
+{
+    workspace.begin(graph.vertex_count());
+    workspace.visit(source);
+    workspace.set_distance(source, 0);
+
+    // touched() grows in BFS order, so it doubles as the queue.
+    const std::vector<uint32_t>& order = workspace.touched();
+    for (size_t head = 0; head < order.size(); head++)
+    {
+        uint32_t u = order[head];
+        unsigned int depth = workspace.distance(u);
+        if (max_depth >= 0 && depth >= unsigned(max_depth)) { break; }
+        for (uint32_t v : graph.neighbours(u))
+        {
+            if (!workspace.is_visited(v))
+            {
+                workspace.visit(v);
+                workspace.set_distance(v, depth + 1);
+                workspace.set_parent(v, u);
+            }
+        }
+    }
+}
+
+// reversed - incoming edges, i.e. graph.reversed(). For an undirected graph pass the graph itself.
+inline BFS_Result direction_optimizing_bfs(const CSR_Graph& graph, const CSR_Graph& reversed, uint32_t source,
+                                           double alpha = 15.0, double beta = 18.0)
+{
+    const uint32_t n = graph.vertex_count();
+    BFS_Result result;
+    result.parents.assign(n, -1);
+    result.depths.assign(n, -1);
+    result.parents[source] = source;
+    result.depths[source] = 0;
+
+    std::vector<uint32_t> queue{source};
+    std::vector<uint32_t> next_queue;
+    Bitmap frontier(n), next_frontier(n);
+
+    uint64_t unexplored_edges = graph.edge_count() - graph.degree(source);
+    uint64_t frontier_edges = graph.degree(source);
+    uint64_t frontier_size = 1;
+    bool bottom_up = false;
+
+    for (int depth = 1; frontier_size > 0; depth++)
+    {
+        if (!bottom_up && frontier_edges > unexplored_edges / alpha)
+        {
+            bottom_up = true;
+            frontier.clear();
+            for (uint32_t u : queue) { frontier.set(u); }
+        }
+        else if (bottom_up && frontier_size < n / beta)
+        {
+            bottom_up = false;
+            queue.clear();
+            for (uint32_t u = 0; u < n; u++) { if (frontier.test(u)) queue.push_back(u); }
+        }
+
+        frontier_edges = 0;
+        frontier_size = 0;
+        if (bottom_up)
+        {
+            next_frontier.clear();
+            for (uint32_t v = 0; v < n; v++)
+            {
+                if (result.parents[v] != -1) { continue; }
+                for (uint32_t u : reversed.neighbours(v))
+                {
+                    result.edges_inspected++;
+                    if (frontier.test(u))
+                    {
+                        result.parents[v] = u;
+                        result.depths[v] = depth;
+                        next_frontier.set(v);
+                        frontier_size++;
+                        frontier_edges += graph.degree(v);
+                        break;
+                    }
+                }
+            }
+            frontier.swap(next_frontier);
+            result.bottom_up_steps++;
+        }
+        else
+        {
+            next_queue.clear();
+            for (uint32_t u : queue)
+            {
+                for (uint32_t v : graph.neighbours(u))
+                {
+                    result.edges_inspected++;
+                    if (result.parents[v] == -1)
+                    {
+                        result.parents[v] = u;
+                        result.depths[v] = depth;
+                        next_queue.push_back(v);
+                        frontier_edges += graph.degree(v);
+                    }
+                }
+            }
+            queue.swap(next_queue);
+            frontier_size = queue.size();
+            result.top_down_steps++;
+        }
+        unexplored_edges -= std::min(unexplored_edges, frontier_edges);
+    }
+    return result;
+}
+
+inline BFS_Result parallel_bfs(const CSR_Graph& graph, uint32_t source, Thread_Pool& pool, bool deterministic = false)
+{
+    const uint32_t n = graph.vertex_count();
+    BFS_Result result;
+    result.parents.assign(n, -1);
+    result.depths.assign(n, -1);
+    result.parents[source] = source;
+    result.depths[source] = 0;
+
+    Bitmap visited(n), claimed(n);
+    visited.set(source);
+
+    std::vector<uint32_t> frontier{source};
+    std::vector<std::vector<uint32_t>> local_next(pool.size());
+    std::vector<uint64_t> local_inspected(pool.size(), 0);
+
+    int* parents = result.parents.data();
+    auto atomic_min_parent = [parents](uint32_t v, int candidate) {
+        int current = __atomic_load_n(&parents[v], __ATOMIC_RELAXED);
+        while ((current == -1 || candidate < current) &&
+               !__atomic_compare_exchange_n(&parents[v], &current, candidate, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+    };
+
+    for (int depth = 1; !frontier.empty(); depth++)
+    {
+        pool.parallel_for(0, frontier.size(), [&](uint64_t index, int thread_index) {
+            uint32_t u = frontier[index];
+            local_inspected[thread_index] += graph.degree(u);
+            for (uint32_t v : graph.neighbours(u))
+            {
+                if (deterministic)
+                {
+                    if (visited.test(v)) { continue; }
+                    atomic_min_parent(v, u);
+                    if (!claimed.test_atomic(v) && claimed.set_atomic(v)) { local_next[thread_index].push_back(v); }
+                }
+                else if (!visited.test_atomic(v) && visited.set_atomic(v))
+                {
+                    result.parents[v] = u;
+                    local_next[thread_index].push_back(v);
+                }
+            }
+        }, 64);
+
+        frontier.clear();
+        for (auto& buffer : local_next)
+        {
+            frontier.insert(frontier.end(), buffer.begin(), buffer.end());
+            buffer.clear();
+        }
+        if (deterministic)
+        {
+            std::sort(frontier.begin(), frontier.end());
+            visited.merge(claimed);
+            claimed.clear();
+        }
+        for (uint32_t v : frontier) { result.depths[v] = depth; }
+        result.top_down_steps++;
+    }
+
+    for (uint64_t inspected : local_inspected) { result.edges_inspected += inspected; }
+    return result;
+}
+
+// Bitset over the sources of one MS-BFS batch: Words * 64 bits.
+template <int Words>
+struct Source_Set
+{
+    public:
+    uint64_t bits[Words] = {};
+
+    bool any() const
+    {
+        uint64_t combined = 0;
+        for (int i = 0; i < Words; i++) { combined |= bits[i]; }
+        return combined != 0;
+    }
+    void set(int source) { bits[source >> 6] |= uint64_t(1) << (source & 63); }
+};
+
+// Runs one batch of at most Words * 64 sources. visit(vertex, set_of_sources, depth) is called once for every vertex
+// and depth at which some sources reach it for the first time. max_depth < 0 - no hop limit.
+template <int Words, typename Visitor>
+void multi_source_bfs_batch(const CSR_Graph& graph, const uint32_t* sources, int count, int max_depth, Visitor visit)
+{
+    const uint32_t n = graph.vertex_count();
+    std::vector<Source_Set<Words>> seen(n), frontier(n), next(n);
+
+    for (int i = 0; i < count; i++) { frontier[sources[i]].set(i); }
+    for (int i = 0; i < count; i++)
+    {
+        uint32_t v = sources[i];
+        if (seen[v].any()) { continue; } // The same vertex given as several sources is reported once.
+        seen[v] = frontier[v];
+        visit(v, frontier[v], 0);
+    }
+
+    bool active = count > 0;
+    for (int depth = 1; active && (max_depth < 0 || depth <= max_depth); depth++)
+    {
+        for (uint32_t v = 0; v < n; v++)
+        {
+            if (!frontier[v].any()) { continue; }
+            for (uint32_t u : graph.neighbours(v))
+            {
+                for (int w = 0; w < Words; w++) { next[u].bits[w] |= frontier[v].bits[w] & ~seen[u].bits[w]; }
+            }
+        }
+
+        active = false;
+        for (uint32_t u = 0; u < n; u++)
+        {
+            frontier[u] = Source_Set<Words>();
+            if (!next[u].any()) { continue; }
+            for (int w = 0; w < Words; w++) { seen[u].bits[w] |= next[u].bits[w]; }
+            visit(u, next[u], depth);
+            frontier[u] = next[u];
+            next[u] = Source_Set<Words>();
+            active = true;
+        }
+    }
+}
+
+// Distance from every source to every vertex (-1 - unreachable or farther than max_depth). distances[i][v].
+template <int Words = 1>
+std::vector<std::vector<int>> multi_source_bfs(const CSR_Graph& graph, const std::vector<uint32_t>& sources, int max_depth = -1)
+{
+    std::vector<std::vector<int>> distances(sources.size(), std::vector<int>(graph.vertex_count(), -1));
+    for (size_t first = 0; first < sources.size(); first += Words * 64)
+    {
+        int count = int(std::min<size_t>(Words * 64, sources.size() - first));
+        multi_source_bfs_batch<Words>(graph, sources.data() + first, count, max_depth,
+            [&](uint32_t v, const Source_Set<Words>& reached, int depth) {
+                for (int w = 0; w < Words; w++)
+                {
+                    for (uint64_t bits = reached.bits[w]; bits != 0; bits &= bits - 1)
+                    {
+                        distances[first + w * 64 + __builtin_ctzll(bits)][v] = depth;
+                    }
+                }
+            });
+    }
+    return distances;
+}
+
+// Vertices within hops edges from every source, the source itself included. Memory is proportional to the answer.
+template <int Words = 1>
+std::vector<std::vector<uint32_t>> multi_source_neighbourhoods(const CSR_Graph& graph, const std::vector<uint32_t>& sources, int hops)
+{
+    std::vector<std::vector<uint32_t>> neighbourhoods(sources.size());
+    for (size_t first = 0; first < sources.size(); first += Words * 64)
+    {
+        int count = int(std::min<size_t>(Words * 64, sources.size() - first));
+        multi_source_bfs_batch<Words>(graph, sources.data() + first, count, hops,
+            [&](uint32_t v, const Source_Set<Words>& reached, int) {
+                for (int w = 0; w < Words; w++)
+                {
+                    for (uint64_t bits = reached.bits[w]; bits != 0; bits &= bits - 1)
+                    {
+                        neighbourhoods[first + w * 64 + __builtin_ctzll(bits)].push_back(v);
+                    }
+                }
+            });
+    }
+    return neighbourhoods;
+}
+
+#endif // BFS_HPP
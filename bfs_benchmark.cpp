@@ -0,0 +1,94 @@
+// Benchmark of the BFS engines from bfs.h on a random low-diameter undirected graph.
+// Reports time and the number of inspected edges, depths of every engine are checked against the top-down BFS.
+// Small-radius queries compare a fresh O(V) setup per query with the generation-stamped Traversal_Workspace.
+// Parallel BFS is measured for 1, 2, 4, ... threads up to all cores on the same graph (strong scaling).
+// Usage: ./bfs_benchmark [vertices] [undirected_edges]     (e.g. 1000000 500000 ... 10000000 50000000)
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cstdlib>
+#include "csr_graph.h"
+#include "bfs.h"
+#include "graph_generators.h"
+#include "thread_pool.h"
+#include "timing.h"
+#include "traversal_workspace.h"
+
+void report(const char* name, double seconds, const BFS_Result& result, const BFS_Result& reference)
+{
+    std::cout << name << seconds << " s\tedges inspected: " << result.edges_inspected
+              << "\tsteps TD/BU: " << result.top_down_steps << "/" << result.bottom_up_steps
+              << (result.depths == reference.depths ? "" : "\tMISMATCH") << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t vertices = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    uint64_t edge_count = argc > 2 ? std::atoll(argv[2]) : 8000000;
+
+    CSR_Graph graph;
+    {
+        Thread_Pool pool;
+        graph = generate_graph(Erdos_Renyi_Generator(vertices, edge_count, 42), pool, true, false);
+    }
+    std::mt19937 rng(42);
+    std::cout << "Vertices: " << vertices << "\tDirected edges: " << graph.edge_count() << std::endl;
+
+    BFS_Result reference, result;
+    double seconds = measure([&]() { reference = top_down_bfs(graph, 0); });
+    report("Top-down:\t\t", seconds, reference, reference);
+
+    seconds = measure([&]() { result = direction_optimizing_bfs(graph, graph, 0); });
+    report("Direction-optimizing:\t", seconds, result, reference);
+
+    // 2-hop neighbourhoods of many random vertices.
+    const int queries = 1000;
+    std::vector<uint32_t> sources(queries);
+    for (auto& source : sources) { source = rng() % vertices; }
+    uint64_t fresh_total = 0, workspace_total = 0;
+    seconds = measure([&]() {
+        for (uint32_t source : sources)
+        {
+            std::vector<int> depth(vertices, -1); // What every call used to pay for.
+            std::vector<uint32_t> queue{source};
+            depth[source] = 0;
+            for (size_t head = 0; head < queue.size() && depth[queue[head]] < 2; head++)
+            {
+                for (uint32_t v : graph.neighbours(queue[head]))
+                {
+                    if (depth[v] == -1) { depth[v] = depth[queue[head]] + 1; queue.push_back(v); }
+                }
+            }
+            fresh_total += queue.size();
+        }
+    });
+    std::cout << queries << " 2-hop queries, O(V) setup:\t" << seconds << " s" << std::endl;
+    Traversal_Workspace workspace;
+    seconds = measure([&]() {
+        for (uint32_t source : sources)
+        {
+            breadth_first_search(graph, source, workspace, 2);
+            workspace_total += workspace.touched().size();
+        }
+    });
+    std::cout << queries << " 2-hop queries, workspace:\t" << seconds << " s"
+              << (fresh_total == workspace_total ? "" : "\tMISMATCH") << std::endl;
+
+    int max_threads = std::max(1u, std::thread::hardware_concurrency());
+    double single_thread = 0;
+    for (int threads = 1; threads <= max_threads; threads = (threads * 2 > max_threads && threads < max_threads) ? max_threads : threads * 2)
+    {
+        Thread_Pool pool(threads);
+        for (bool deterministic : {false, true})
+        {
+            seconds = measure([&]() { result = parallel_bfs(graph, 0, pool, deterministic); });
+            if (threads == 1 && !deterministic) { single_thread = seconds; }
+            std::cout << "Parallel, threads: " << threads << (deterministic ? " deterministic\t" : "\t\t")
+                      << seconds << " s\tspeedup: " << single_thread / seconds
+                      << (result.depths == reference.depths ? "" : "\tMISMATCH") << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+// Point-to-point queries on a road-like grid (right and lower neighbour, weights 1..1000) and on a random graph:
+// full Dijkstra, Dijkstra which stops when end is settled, and bidirectional Dijkstra.
+// Reports the average number of settled vertices per query and the time, distances are checked against full Dijkstra.
+// Usage: ./bidirectional_benchmark [width] [height] [queries]
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cstdlib>
+#include "csr_graph.h"
+#include "graph_generators.h"
+#include "shortest_paths.h"
+#include "thread_pool.h"
+#include "timing.h"
+#include "traversal_workspace.h"
+
+void run_queries(const char* name, const CSR_Graph& graph, int queries, std::mt19937& rng)
+{
+    CSR_Graph reversed = graph.reversed();
+    std::vector<std::pair<uint32_t, uint32_t>> pairs(queries);
+    for (auto& pair : pairs) { pair = {rng() % graph.vertex_count(), rng() % graph.vertex_count()}; }
+    std::cout << name << "\tvertices: " << graph.vertex_count() << "\tedges: " << graph.edge_count() << std::endl;
+
+    Traversal_Workspace forward, backward;
+    std::vector<unsigned int> expected(queries);
+    uint64_t settled = 0;
+    double seconds = measure([&]() {
+        for (int i = 0; i < queries; i++)
+        {
+            settled += dijkstra(graph, pairs[i].first, forward);
+            expected[i] = forward.distance(pairs[i].second);
+        }
+    });
+    double full = settled / double(queries);
+    std::cout << "  Full Dijkstra:\t\t" << seconds / queries * 1e3 << " ms/query\tsettled: " << full << std::endl;
+
+    settled = 0;
+    bool correct = true;
+    seconds = measure([&]() {
+        for (int i = 0; i < queries; i++)
+        {
+            settled += dijkstra(graph, pairs[i].first, forward, pairs[i].second);
+            correct &= forward.distance(pairs[i].second) == expected[i];
+        }
+    });
+    std::cout << "  Stop at end:\t\t" << seconds / queries * 1e3 << " ms/query\tsettled: " << settled / double(queries)
+              << "\treduction: " << full / (settled / double(queries)) << "x" << (correct ? "" : "\tMISMATCH") << std::endl;
+
+    settled = 0;
+    seconds = measure([&]() {
+        for (int i = 0; i < queries; i++)
+        {
+            Bidirectional_Result result = bidirectional_dijkstra(graph, reversed, pairs[i].first, pairs[i].second, forward, backward);
+            settled += result.settled;
+            correct &= result.distance == expected[i];
+        }
+    });
+    std::cout << "  Bidirectional:\t" << seconds / queries * 1e3 << " ms/query\tsettled: " << settled / double(queries)
+              << "\treduction: " << full / (settled / double(queries)) << "x" << (correct ? "" : "\tMISMATCH") << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t width = argc > 1 ? std::atoi(argv[1]) : 500;
+    uint32_t height = argc > 2 ? std::atoi(argv[2]) : 500;
+    int queries = argc > 3 ? std::atoi(argv[3]) : 100;
+    uint32_t vertices = width * height;
+
+    std::mt19937 rng(42);
+    Thread_Pool pool;
+    run_queries("Grid", generate_graph(Grid_Generator(width, height, 42), pool, true), queries, rng);
+    run_queries("Random, directed", generate_graph(Erdos_Renyi_Generator(vertices, 4ull * vertices, 42, 1000), pool), queries, rng);
+
+    return 0;
+}
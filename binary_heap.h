@@ -0,0 +1,186 @@
+#ifndef BINARY_HEAP_HPP
+#define BINARY_HEAP_HPP
+
+// A binary heap is commonly used to implement a priority queue ( abstract data type ).
+// There are two types of binary heaps: max_heap (root = max_node), min_heap (root = min_node).
+// Max_Heap<T, Compare> keeps on top the element which is the greatest according to Compare (as std::priority_queue does):
+// Max_Heap<int> is a max_heap, Max_Heap<int, std::greater<int>> is a min_heap.
+// Typically stored as an array for memory efficiency: children of index i are 2 * i + 1 and 2 * i + 2.
+//
+// Free functions below work on any random access range, Max_Heap is a growable array on top of them:
+// build_heap()  - Floyd's bottom-up heap construction, O(n).
+// heap_sort()   - in-place sort, O(n log n), no extra memory.
+
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+// Sifting down is used when the root of a subtree may be smaller than its children (after extraction or during build).
+// Instead of swapping on every level we keep a "hole": children are moved up, the element is written once at the end.
+//          40                          18                        18                         30
+//        /     \                     /     \                   /    \                     /     \ .
+//      30      21        ->        30      21          ->    30   21           ->      18      21
+//    /   \    /   \               /  \    /  \              /  \                        /  \ .
+//  12    6   18                  12   6  40                12   6                       12   6
+//
+//  40 30 21 12 6 18      ->   18 30 21 12 6 40  ->   18 30 21 12 6 (Violation!)   ->    30 18 21 12 6
+template <typename Iterator, typename Compare>
+void heap_sift_down(Iterator first, long long index, long long size, Compare compare)
+{
+    auto element = std::move(first[index]);
+    long long child = 2 * index + 1;
+    while (child < size)
+    {
+        if (child + 1 < size && compare(first[child], first[child + 1])) { child++; }
+        if (!compare(element, first[child])) { break; }
+        first[index] = std::move(first[child]);
+        index = child;
+        child = 2 * index + 1;
+    }
+    first[index] = std::move(element);
+}
+
+// Sifting up is used when you are inserting a new element inside a heap.
+//          40                          40
+//        /     \                     /     \ .
+//      30      21        ->        30      38
+//    /   \    /   \               /  \    /  \ .
+//  12    6   18    38            12   6  18   21
+//
+//  40 30 21 12 6 18 38   ->   40 30 38 12 6 18 21
+template <typename Iterator, typename Compare>
+void heap_sift_up(Iterator first, long long index, Compare compare)
+{
+    auto element = std::move(first[index]);
+    while (index > 0)
+    {
+        long long parent = (index - 1) / 2;
+        if (!compare(first[parent], element)) { break; }
+        first[index] = std::move(first[parent]);
+        index = parent;
+    }
+    first[index] = std::move(element);
+}
+
+// Leaves are already heaps. Sift down every inner node starting from the last one.
+// Half of the nodes are leaves, a quarter sifts at most one level, an eighth two levels...: sum is O(n), not O(n log n).
+template <typename Iterator, typename Compare = std::less<>>
+void build_heap(Iterator first, Iterator last, Compare compare = Compare())
+{
+    long long size = last - first;
+    for (long long index = size / 2 - 1; index >= 0; index--)
+    {
+        heap_sift_down(first, index, size, compare);
+    }
+}
+
+// Build a heap, then repeatedly move the root (the greatest element) behind the shrinking heap. Result is ascending.
+template <typename Iterator, typename Compare = std::less<>>
+void heap_sort(Iterator first, Iterator last, Compare compare = Compare())
+{
+    build_heap(first, last, compare);
+    for (long long size = last - first; size > 1; size--)
+    {
+        std::swap(first[0], first[size - 1]);
+        heap_sift_down(first, 0, size - 1, compare);
+    }
+}
+
+template <typename T, typename Compare = std::less<T>>
+struct Max_Heap
+{
+    private:
+    size_t capacity;
+    size_t size;
+    T* heap_array;
+    Compare compare;
+
+    void reserve(size_t new_capacity)
+    {
+        if (new_capacity <= capacity) { return; }
+        T* new_heap_array = new T[new_capacity];
+        for (size_t i = 0; i < size; i++)
+        {
+            new_heap_array[i] = std::move(heap_array[i]);
+        }
+        delete[] heap_array;
+        heap_array = new_heap_array;
+        capacity = new_capacity;
+    }
+
+    public:
+    Max_Heap(size_t capacity_ = 16, Compare compare_ = Compare()) : capacity(capacity_ > 0 ? capacity_ : 1), size(0), compare(compare_)
+    {
+        heap_array = new T[capacity];
+    }
+
+    Max_Heap(const Max_Heap&) = delete;
+    Max_Heap& operator=(const Max_Heap&) = delete;
+
+    ~Max_Heap()
+    {
+        delete[] heap_array;
+    }
+
+    // Replace the content with [first, last) and heapify it in O(n).
+    template <typename Iterator>
+    void build_heap(Iterator first, Iterator last)
+    {
+        size = 0;
+        reserve(last - first);
+        for (Iterator it = first; it != last; ++it)
+        {
+            heap_array[size++] = *it;
+        }
+        ::build_heap(heap_array, heap_array + size, compare);
+    }
+
+    // When the array is full it is reallocated with doubled capacity: amortized O(1) per element plus O(log n) sifting.
+    void push(const T& element)
+    {
+        if (size == capacity) { reserve(2 * capacity); }
+        heap_array[size] = element;
+        heap_sift_up(heap_array, size, compare);
+        size++;
+    }
+
+    void insert(const T& element) { push(element); }
+
+    const T& peek() const
+    {
+        if (size == 0) { throw std::out_of_range("Heap is empty"); }
+        return heap_array[0];
+    }
+
+    // Main difference between method below and above is: in peek() we merely access the max element.
+    // In extract_peek() we extract max element and delete it. The last element takes the place of the root and sifts down:
+    // O(log n), no allocation.
+    void extract_peek()
+    {
+        if (size == 0) { throw std::out_of_range("Heap is empty"); }
+        size--;
+        if (size > 0)
+        {
+            heap_array[0] = std::move(heap_array[size]);
+            heap_sift_down(heap_array, 0, size, compare);
+        }
+    }
+
+    // Extract the top and insert element with a single sift down: cheaper than extract_peek() followed by push().
+    void replace_peek(const T& element)
+    {
+        if (size == 0) { throw std::out_of_range("Heap is empty"); }
+        heap_array[0] = element;
+        heap_sift_down(heap_array, 0, size, compare);
+    }
+
+    const T* data() const { return heap_array; }
+
+    size_t get_size() const { return size; }
+
+    bool is_empty() const { return size == 0; }
+
+    void clear() { size = 0; }
+};
+
+#endif // BINARY_HEAP_HPP
@@ -0,0 +1,50 @@
+#ifndef BITMAP_HPP
+#define BITMAP_HPP
+
+// Dense set of vertices: one bit per vertex packed into 64-bit words.
+// 32 times smaller than std::vector<int> and 8 times smaller than std::vector<char>, so a frontier of a huge graph
+// stays in cache, and an empty word lets a scan skip 64 vertices at once.
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+class Bitmap
+{
+    private:
+    uint64_t bits;
+    std::vector<uint64_t> words;
+
+    public:
+    Bitmap(uint64_t bits_ = 0) : bits(bits_), words((bits_ + 63) / 64, 0) {}
+
+    void set(uint64_t index) { words[index >> 6] |= uint64_t(1) << (index & 63); }
+    void reset(uint64_t index) { words[index >> 6] &= ~(uint64_t(1) << (index & 63)); }
+    bool test(uint64_t index) const { return (words[index >> 6] >> (index & 63)) & 1; }
+
+    // Safe to call from several threads at once. Returns true only for the thread which actually flipped the bit.
+    bool set_atomic(uint64_t index)
+    {
+        uint64_t mask = uint64_t(1) << (index & 63);
+        return !(__atomic_fetch_or(&words[index >> 6], mask, __ATOMIC_RELAXED) & mask);
+    }
+    bool test_atomic(uint64_t index) const { return (__atomic_load_n(&words[index >> 6], __ATOMIC_RELAXED) >> (index & 63)) & 1; }
+
+    void clear() { std::fill(words.begin(), words.end(), 0); }
+    void merge(const Bitmap& other) { for (uint64_t i = 0; i < words.size(); i++) words[i] |= other.words[i]; }
+    void swap(Bitmap& other) { std::swap(bits, other.bits); words.swap(other.words); }
+
+    uint64_t count() const
+    {
+        uint64_t total = 0;
+        for (uint64_t word : words) { total += __builtin_popcountll(word); }
+        return total;
+    }
+
+    uint64_t size() const { return bits; }
+    uint64_t word_count() const { return words.size(); }
+    uint64_t word(uint64_t index) const { return words[index]; }
+    uint64_t* data() { return words.data(); }
+};
+
+#endif // BITMAP_HPP
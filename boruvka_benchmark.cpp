@@ -0,0 +1,70 @@
+// Differential test and benchmark of the parallel boruvka() from spanning_tree.h against Kruskal (sort + scan) and
+// filter-Kruskal: total weight and number of forest edges must be equal, and the forest must be a forest of the input.
+// A random graph (left disconnected on purpose when edges < vertices) and a road-like grid; strong scaling for
+// 1, 2, 4, ... threads up to all cores.
+// Usage: ./boruvka_benchmark [vertices] [edges] [grid_side]     (e.g. 10000000 100000000 for 10^8 edges)
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+#include "csr_graph.h"
+#include "graph_generators.h"
+#include "spanning_tree.h"
+#include "thread_pool.h"
+#include "timing.h"
+
+void run(const char* name, const std::vector<CSR_Edge>& edges, uint32_t vertices)
+{
+    std::cout << name << "\tvertices: " << vertices << "\tedges: " << edges.size() << std::endl;
+    Spanning_Forest expected;
+    double seconds = measure([&]() { expected = sorting_kruskal(edges, vertices); });
+    std::cout << "  Kruskal:\t\t" << seconds << " s\tforest edges: " << expected.edges.size() << "\tweight: " << expected.total_weight << std::endl;
+
+    int max_threads = std::max(1u, std::thread::hardware_concurrency());
+    double single_thread = 0;
+    for (int threads = 1; threads <= max_threads; threads = (threads * 2 > max_threads && threads < max_threads) ? max_threads : threads * 2)
+    {
+        Thread_Pool pool(threads);
+        Spanning_Forest forest;
+        seconds = measure([&]() { forest = boruvka(edges, vertices, pool); });
+        if (threads == 1) { single_thread = seconds; }
+
+        // No cycle among the chosen edges, and as many of them as Kruskal chose: a spanning forest of the same weight.
+        Union_Find sets(vertices);
+        bool correct = forest.total_weight == expected.total_weight && forest.edges.size() == expected.edges.size();
+        for (const CSR_Edge& edge : forest.edges) { correct &= sets.unite(edge.vertex_from, edge.vertex_to); }
+        std::cout << "  Boruvka, threads: " << threads << "\t" << seconds << " s\tspeedup: " << single_thread / seconds
+                  << (correct ? "" : "\tMISMATCH") << std::endl;
+
+        if (threads == max_threads)
+        {
+            std::vector<CSR_Edge> copy = edges;
+            seconds = measure([&]() { forest = filter_kruskal(copy, vertices, pool); });
+            correct = forest.total_weight == expected.total_weight && forest.edges.size() == expected.edges.size();
+            std::cout << "  Filter-Kruskal, threads: " << threads << "\t" << seconds << " s" << (correct ? "" : "\tMISMATCH") << std::endl;
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t vertices = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    uint64_t edge_count = argc > 2 ? std::atoll(argv[2]) : 10000000;
+    uint32_t side = argc > 3 ? std::atoi(argv[3]) : 1000;
+
+    std::vector<CSR_Edge> edges;
+    {
+        Thread_Pool pool;
+        edges = generate_edges(Erdos_Renyi_Generator(vertices, edge_count, 42, 1000000), pool);
+    }
+    run("Random", edges, vertices);
+    {
+        Thread_Pool pool;
+        edges = generate_edges(Grid_Generator(side, side, 42, 1000000), pool);
+    }
+    run("Grid", edges, side * side);
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Contraction Hierarchies on a road-like grid (right and lower neighbour, weights 1..1000) and on the same grid where half
+// of the streets are one-way: preprocessing time and shortcuts, then point-to-point queries against Dijkstra which stops at end.
+// Distances are compared, unpacked paths are checked to be paths of the original graph with exactly that length.
+// Usage: ./ch_benchmark [width] [height] [queries]
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cstdlib>
+#include <memory>
+#include "csr_graph.h"
+#include "shortest_paths.h"
+#include "contraction_hierarchies.h"
+#include "graph_generators.h"
+#include "thread_pool.h"
+#include "timing.h"
+#include "traversal_workspace.h"
+
+// Length of the path in graph, INF if two consecutive vertices are not connected.
+unsigned int path_length(const CSR_Graph& graph, const std::vector<uint32_t>& path)
+{
+    unsigned int length = 0;
+    for (size_t i = 0; i + 1 < path.size(); i++)
+    {
+        unsigned int lightest = Traversal_Workspace::INF;
+        for (uint64_t edge = graph.first_edge(path[i]); edge < graph.last_edge(path[i]); edge++)
+        {
+            if (graph.target(edge) == path[i + 1]) { lightest = std::min(lightest, unsigned(graph.weight(edge))); }
+        }
+        if (lightest == Traversal_Workspace::INF) { return lightest; }
+        length += lightest;
+    }
+    return length;
+}
+
+void run_queries(const char* name, const CSR_Graph& graph, Thread_Pool& pool, int queries, std::mt19937& rng)
+{
+    std::cout << name << "\tvertices: " << graph.vertex_count() << "\tedges: " << graph.edge_count() << std::endl;
+    std::unique_ptr<Contraction_Hierarchy> hierarchy;
+    double seconds = measure([&]() { hierarchy.reset(new Contraction_Hierarchy(graph, pool)); });
+    std::cout << "  Preprocessing:\t" << seconds << " s\tshortcuts: " << hierarchy->shortcut_count()
+              << "\tsearch graph edges: " << hierarchy->edge_count() << "\tthreads: " << pool.size() << std::endl;
+
+    std::vector<std::pair<uint32_t, uint32_t>> pairs(queries);
+    for (auto& pair : pairs) { pair = {rng() % graph.vertex_count(), rng() % graph.vertex_count()}; }
+
+    Traversal_Workspace forward, backward;
+    std::vector<unsigned int> expected(queries);
+    uint64_t settled = 0;
+    seconds = measure([&]() {
+        for (int i = 0; i < queries; i++)
+        {
+            settled += dijkstra(graph, pairs[i].first, forward, pairs[i].second);
+            expected[i] = forward.distance(pairs[i].second);
+        }
+    });
+    std::cout << "  Dijkstra:\t\t" << seconds / queries * 1e6 << " us/query\tsettled: " << settled / double(queries) << std::endl;
+
+    settled = 0;
+    bool correct = true;
+    std::vector<Bidirectional_Result> results(queries);
+    seconds = measure([&]() {
+        for (int i = 0; i < queries; i++)
+        {
+            results[i] = hierarchy->query(pairs[i].first, pairs[i].second, forward, backward);
+            settled += results[i].settled;
+        }
+    });
+    for (int i = 0; i < queries; i++) { correct &= results[i].distance == expected[i]; }
+    std::cout << "  CH query:\t\t" << seconds / queries * 1e6 << " us/query\tsettled: " << settled / double(queries)
+              << (correct ? "" : "\tMISMATCH") << std::endl;
+
+    seconds = measure([&]() {
+        for (int i = 0; i < queries; i++)
+        {
+            Bidirectional_Result result = hierarchy->query(pairs[i].first, pairs[i].second, forward, backward);
+            std::vector<uint32_t> path = hierarchy->unpack_path(forward, backward, result);
+            if (result.distance == Traversal_Workspace::INF) { correct &= path.empty(); continue; }
+            correct &= path.front() == pairs[i].first && path.back() == pairs[i].second && path_length(graph, path) == expected[i];
+        }
+    });
+    std::cout << "  CH query + path:\t" << seconds / queries * 1e6 << " us/query" << (correct ? "" : "\tMISMATCH") << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t width = argc > 1 ? std::atoi(argv[1]) : 150;
+    uint32_t height = argc > 2 ? std::atoi(argv[2]) : 150;
+    int queries = argc > 3 ? std::atoi(argv[3]) : 1000;
+    uint32_t vertices = width * height;
+
+    std::mt19937 rng(42);
+    Thread_Pool pool;
+    std::vector<CSR_Edge> edges = generate_edges(Grid_Generator(width, height, 42), pool);
+    run_queries("Grid", CSR_Graph::from_edges(vertices, edges, true), pool, queries, rng);
+
+    // One-way streets: every second edge of the grid exists in one direction only.
+    for (CSR_Edge& edge : edges) { if (rng() % 4 == 0) { std::swap(edge.vertex_from, edge.vertex_to); } }
+    std::vector<CSR_Edge> directed;
+    for (size_t i = 0; i < edges.size(); i++)
+    {
+        directed.push_back(edges[i]);
+        if (i % 2 == 0) { directed.emplace_back(edges[i].vertex_to, edges[i].vertex_from, edges[i].weight); }
+    }
+    run_queries("Grid, one-way streets", CSR_Graph::from_edges(vertices, directed), pool, queries, rng);
+
+    return 0;
+}
@@ -0,0 +1,258 @@
+#ifndef COMPRESSED_GRAPH_HPP
+#define COMPRESSED_GRAPH_HPP
+
+// Immutable graph in a fraction of the memory of CSR_Graph, with the same neighbour interface, so the engines of bfs.h,
+// dfs.h and shortest_paths.h run on it unchanged. Every vertex owns one block of bytes; offsets[v] is where it starts:
+//
+//     [ degree: varint ][ weights: degree * bits, bit-packed ][ gaps: varint, varint, ... ]
+//
+// Neighbour lists are sorted, so they are stored as gaps: the first target as it is, then differences to the previous
+// target. A varint keeps 7 bits per byte and the high bit says "more bytes follow": gaps below 128 take one byte,
+// below 16384 two. Weights are stored as weight - min_weight in exactly as many bits as max_weight - min_weight needs.
+//
+//     targets 1000, 1003, 1004, 1290  ->  gaps 1000, 3, 1, 286  ->  bytes e8 07 | 03 | 01 | 9e 02      (6 instead of 16)
+//     weights 1..1000                 ->  10 bits per edge instead of 32
+//
+// Gaps are small when neighbours have close ids, which is what a locality order of graph_reorder.h (RCM, Gorder)
+// produces; on such graphs 4 + 4 bytes per edge shrink to 2-3, the cost is a few instructions of decoding per
+// neighbour. Decoding is sequential, so there is no target(edge) random access: neighbours(v) and edges(v) are
+// forward ranges, next_neighbour() resumes a scan from (position, previous target).
+// Byte-aligned varint rather than a SIMD layout such as StreamVByte: that one needs SSSE3 shuffles, the builds here
+// only assume SSE2, and the one-byte case, which dominates on reordered graphs, is a single predictable branch.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include "csr_graph.h"
+#include "thread_pool.h"
+
+class Compressed_Graph
+{
+    public:
+    using Weighted_Neighbour = CSR_Graph::Weighted_Neighbour;
+
+    static uint32_t read_varint(const uint8_t*& position)
+    {
+        uint32_t byte = *position++;
+        if (byte < 0x80) { return byte; }
+        uint32_t value = byte & 0x7f;
+        for (int shift = 7; ; shift += 7)
+        {
+            byte = *position++;
+            value |= (byte & 0x7f) << shift;
+            if (byte < 0x80) { return value; }
+        }
+    }
+
+    static uint8_t* write_varint(uint8_t* position, uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            *position++ = uint8_t(value | 0x80);
+            value >>= 7;
+        }
+        *position++ = uint8_t(value);
+        return position;
+    }
+
+    static uint32_t varint_size(uint32_t value)
+    {
+        uint32_t size = 1;
+        while (value >= 0x80) { value >>= 7; size++; }
+        return size;
+    }
+
+    // Targets of one vertex, decoded one by one: for (uint32_t v : graph.neighbours(u)) {...}
+    class Neighbour_Iterator
+    {
+        private:
+        const uint8_t* position; // Varint of the current target.
+        const uint8_t* last;
+        const uint8_t* next = nullptr;
+        uint32_t value = 0;
+
+        void decode()
+        {
+            if (position == last) { return; }
+            next = position;
+            value += read_varint(next);
+        }
+
+        public:
+        Neighbour_Iterator(const uint8_t* position_, const uint8_t* last_) : position(position_), last(last_) { decode(); }
+        uint32_t operator*() const { return value; }
+        Neighbour_Iterator& operator++() { position = next; decode(); return *this; }
+        bool operator!=(const Neighbour_Iterator& other) const { return position != other.position; }
+    };
+
+    // Targets with their weights: for (auto edge : graph.edges(u)) { edge.target, edge.weight }.
+    class Edge_Iterator
+    {
+        private:
+        Neighbour_Iterator target;
+        const uint8_t* weights;
+        uint64_t bit = 0;
+        uint32_t bits;
+        int32_t min_weight;
+
+        public:
+        Edge_Iterator(Neighbour_Iterator target_, const uint8_t* weights_, uint32_t bits_, int32_t min_weight_)
+            : target(target_), weights(weights_), bits(bits_), min_weight(min_weight_) {}
+
+        Weighted_Neighbour operator*() const
+        {
+            // Eight bytes from the byte holding the first bit; the buffer is padded so this never reads past it.
+            uint64_t word;
+            std::memcpy(&word, weights + (bit >> 3), sizeof(word));
+            uint64_t packed = (word >> (bit & 7)) & ((uint64_t(1) << bits) - 1);
+            return {*target, int32_t(int64_t(min_weight) + int64_t(packed))};
+        }
+        Edge_Iterator& operator++() { ++target; bit += bits; return *this; }
+        bool operator!=(const Edge_Iterator& other) const { return target != other.target; }
+    };
+
+    template <typename Iterator>
+    struct Range
+    {
+        Iterator first;
+        Iterator last;
+        Iterator begin() const { return first; }
+        Iterator end() const { return last; }
+    };
+
+    private:
+    static constexpr uint64_t padding = 8; // Bytes behind the last block for the 8-byte weight reads.
+
+    uint32_t V = 0;
+    uint64_t E = 0;
+    bool weighted = false;
+    uint32_t weight_bits = 0; // 0 if unweighted or all weights are equal.
+    int32_t min_weight = 1;
+    std::vector<uint64_t> offsets;
+    std::vector<uint8_t> data;
+
+    // Start of the weights of v; degree is set to the degree of v.
+    const uint8_t* weights_of(uint32_t v, uint32_t& degree) const
+    {
+        const uint8_t* position = data.data() + offsets[v];
+        degree = read_varint(position);
+        return position;
+    }
+
+    uint64_t weight_bytes(uint32_t degree) const { return (uint64_t(degree) * weight_bits + 7) / 8; }
+
+    public:
+    Compressed_Graph() : offsets(1, 0), data(padding, 0) {}
+
+    // Encodes all vertices on the pool: block sizes, prefix sums, then every vertex writes its own block.
+    static Compressed_Graph from_csr(const CSR_Graph& graph, Thread_Pool& pool)
+    {
+        Compressed_Graph compressed;
+        uint32_t vertices = graph.vertex_count();
+        compressed.V = vertices;
+        compressed.E = graph.edge_count();
+        compressed.weighted = graph.is_weighted();
+        if (graph.is_weighted() && graph.edge_count() > 0)
+        {
+            auto range = std::minmax_element(graph.weight_data(), graph.weight_data() + graph.edge_count());
+            uint64_t span = uint64_t(int64_t(*range.second) - int64_t(*range.first));
+            compressed.min_weight = *range.first;
+            while (compressed.weight_bits < 32 && (span >> compressed.weight_bits) != 0) { compressed.weight_bits++; }
+        }
+
+        // Sorted (target, weight) list of every vertex, in per-thread scratch.
+        std::vector<std::vector<std::pair<uint32_t, int32_t>>> scratch(pool.size());
+        auto sorted_list = [&](uint32_t v, int thread_index) -> std::vector<std::pair<uint32_t, int32_t>>& {
+            std::vector<std::pair<uint32_t, int32_t>>& list = scratch[thread_index];
+            list.clear();
+            for (uint64_t edge = graph.first_edge(v); edge < graph.last_edge(v); edge++) { list.emplace_back(graph.target(edge), graph.weight(edge)); }
+            std::sort(list.begin(), list.end());
+            return list;
+        };
+
+        std::vector<uint64_t>& offsets = compressed.offsets;
+        offsets.assign(uint64_t(vertices) + 1, 0);
+        pool.parallel_for(0, vertices, [&](uint64_t v, int thread_index) {
+            const auto& list = sorted_list(uint32_t(v), thread_index);
+            uint64_t size = varint_size(uint32_t(list.size())) + compressed.weight_bytes(uint32_t(list.size()));
+            uint32_t previous = 0;
+            for (const auto& neighbour : list) { size += varint_size(neighbour.first - previous); previous = neighbour.first; }
+            offsets[v + 1] = size;
+        });
+        for (uint32_t v = 0; v < vertices; v++) { offsets[v + 1] += offsets[v]; }
+
+        compressed.data.assign(offsets[vertices] + padding, 0);
+        pool.parallel_for(0, vertices, [&](uint64_t v, int thread_index) {
+            const auto& list = sorted_list(uint32_t(v), thread_index);
+            uint8_t* position = write_varint(compressed.data.data() + offsets[v], uint32_t(list.size()));
+            if (compressed.weight_bits > 0)
+            {
+                // Blocks are byte-aligned, so the bits of one vertex never share a byte with another vertex.
+                uint64_t bit = 0;
+                for (const auto& neighbour : list)
+                {
+                    uint64_t packed = uint64_t(int64_t(neighbour.second) - int64_t(compressed.min_weight));
+                    for (uint32_t b = 0; b < compressed.weight_bits; b++, bit++)
+                    {
+                        if ((packed >> b) & 1) { position[bit >> 3] |= uint8_t(1u << (bit & 7)); }
+                    }
+                }
+                position += compressed.weight_bytes(uint32_t(list.size()));
+            }
+            uint32_t previous = 0;
+            for (const auto& neighbour : list) { position = write_varint(position, neighbour.first - previous); previous = neighbour.first; }
+        });
+        return compressed;
+    }
+
+    uint32_t vertex_count() const { return V; }
+    uint64_t edge_count() const { return E; }
+    bool is_weighted() const { return weighted; }
+    uint32_t bits_per_weight() const { return weight_bits; }
+
+    uint32_t degree(uint32_t v) const
+    {
+        const uint8_t* position = data.data() + offsets[v];
+        return read_varint(position);
+    }
+
+    // Positions in the byte array, for next_neighbour(): the gaps of v are [first_edge(v), last_edge(v)).
+    uint64_t first_edge(uint32_t v) const
+    {
+        uint32_t degree;
+        const uint8_t* weights = weights_of(v, degree);
+        return uint64_t(weights - data.data()) + weight_bytes(degree);
+    }
+    uint64_t last_edge(uint32_t v) const { return offsets[v + 1]; }
+
+    // The target at edge, previous is the target before it (0 at first_edge); both move on to the next one.
+    uint32_t next_neighbour(uint64_t& edge, uint32_t& previous) const
+    {
+        const uint8_t* position = data.data() + edge;
+        previous += read_varint(position);
+        edge = uint64_t(position - data.data());
+        return previous;
+    }
+
+    Range<Neighbour_Iterator> neighbours(uint32_t v) const
+    {
+        const uint8_t* last = data.data() + offsets[v + 1];
+        return {{data.data() + first_edge(v), last}, {last, last}};
+    }
+
+    // Weight 1 for every edge of an unweighted graph (min_weight is 1 and no bits are stored).
+    Range<Edge_Iterator> edges(uint32_t v) const
+    {
+        uint32_t degree;
+        const uint8_t* weights = weights_of(v, degree);
+        const uint8_t* last = data.data() + offsets[v + 1];
+        return {{{weights + weight_bytes(degree), last}, weights, weight_bits, min_weight},
+                {{last, last}, weights, weight_bits, min_weight}};
+    }
+
+    uint64_t memory_bytes() const { return offsets.size() * sizeof(uint64_t) + data.size(); }
+};
+
+#endif // COMPRESSED_GRAPH_HPP
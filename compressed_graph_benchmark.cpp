@@ -0,0 +1,97 @@
+// Compressed_Graph (compressed_graph.h) against CSR_Graph: bytes per edge, build time, and BFS, DFS and Dijkstra run
+// on both through the same engines. The CSR reference has sorted neighbour lists (permuted by the identity), so the
+// traversal orders are identical and every BFS tree, DFS pre-order and distance must match exactly.
+// Inputs: a grid and an R-MAT graph, each with the ids of the generator and after reverse Cuthill-McKee (graph_reorder.h),
+// which gives small gaps and therefore short varints.
+// Usage: ./compressed_graph_benchmark [grid_side] [rmat_scale]
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include "bfs.h"
+#include "compressed_graph.h"
+#include "csr_graph.h"
+#include "dfs.h"
+#include "graph_generators.h"
+#include "graph_reorder.h"
+#include "shortest_paths.h"
+#include "thread_pool.h"
+#include "timing.h"
+#include "traversal_workspace.h"
+
+struct Traversal_Answers
+{
+    public:
+    std::vector<uint32_t> bfs_order, dfs_order;
+    std::vector<int> bfs_parents;
+    std::vector<unsigned int> distances;
+    double bfs_seconds = 0, dfs_seconds = 0, dijkstra_seconds = 0;
+};
+
+template <typename Graph>
+Traversal_Answers traverse(const Graph& graph, const std::vector<uint32_t>& sources)
+{
+    Traversal_Answers answers;
+    Traversal_Workspace workspace;
+    answers.bfs_seconds = measure([&]() {
+        for (uint32_t source : sources)
+        {
+            breadth_first_search(graph, source, workspace);
+            for (uint32_t v : workspace.touched()) { answers.bfs_order.push_back(v); answers.bfs_parents.push_back(workspace.parent(v)); }
+        }
+    });
+    answers.dijkstra_seconds = measure([&]() {
+        for (uint32_t source : sources)
+        {
+            dijkstra(graph, source, workspace);
+            for (uint32_t v : workspace.touched()) { answers.distances.push_back(workspace.distance(v)); }
+        }
+    });
+    DFS_Workspace dfs_workspace;
+    DFS_Visitor visitor;
+    answers.dfs_seconds = measure([&]() { depth_first_search(graph, visitor, dfs_workspace); });
+    answers.dfs_order = dfs_workspace.touched();
+    return answers;
+}
+
+void run(const char* name, const CSR_Graph& input, Thread_Pool& pool)
+{
+    std::vector<uint32_t> identity(input.vertex_count());
+    for (uint32_t v = 0; v < identity.size(); v++) { identity[v] = v; }
+    CSR_Graph graph = input.permuted(identity);
+    Compressed_Graph compressed;
+    double build_seconds = measure([&]() { compressed = Compressed_Graph::from_csr(graph, pool); });
+
+    double csr_bytes = double(graph.memory_bytes()), compressed_bytes = double(compressed.memory_bytes());
+    std::cout << name << "\tvertices: " << graph.vertex_count() << "\tedges: " << graph.edge_count() << "\tlog gap: " << average_log_gap(graph) << std::endl;
+    std::cout << "  CSR: " << csr_bytes / graph.edge_count() << " bytes/edge\tcompressed: " << compressed_bytes / graph.edge_count()
+              << " bytes/edge (" << compressed.bits_per_weight() << " bits/weight)\tratio: " << csr_bytes / compressed_bytes
+              << "\tbuild: " << build_seconds << " s" << std::endl;
+
+    std::vector<uint32_t> sources;
+    for (uint32_t i = 0; i < 8; i++) { sources.push_back(uint32_t(Edge_Random(42, i).below(graph.vertex_count()))); }
+    Traversal_Answers expected = traverse(graph, sources);
+    Traversal_Answers answers = traverse(compressed, sources);
+    auto line = [](const char* engine, double csr, double compressed, bool correct) {
+        std::cout << "  " << engine << "\tCSR: " << csr << " s\tcompressed: " << compressed << " s\tslowdown: " << compressed / csr
+                  << (correct ? "" : "\tMISMATCH") << std::endl;
+    };
+    line("BFS x8", expected.bfs_seconds, answers.bfs_seconds, expected.bfs_order == answers.bfs_order && expected.bfs_parents == answers.bfs_parents);
+    line("DFS", expected.dfs_seconds, answers.dfs_seconds, expected.dfs_order == answers.dfs_order);
+    line("Dijkstra x8", expected.dijkstra_seconds, answers.dijkstra_seconds, expected.distances == answers.distances);
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t side = argc > 1 ? std::atoi(argv[1]) : 1000;
+    uint32_t scale = argc > 2 ? std::atoi(argv[2]) : 18;
+
+    Thread_Pool pool;
+    CSR_Graph grid = generate_graph(Grid_Generator(side, side, 42, 1000), pool, true);
+    run("Grid", grid, pool);
+    run("Grid, RCM", reorder(grid, reverse_cuthill_mckee(grid)), pool);
+    CSR_Graph rmat = generate_graph(RMAT_Generator(scale, 16, 42, 1000), pool, true);
+    run("R-MAT", rmat, pool);
+    run("R-MAT, RCM", reorder(rmat, reverse_cuthill_mckee(rmat)), pool);
+    return 0;
+}
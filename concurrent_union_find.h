@@ -0,0 +1,114 @@
+#ifndef CONCURRENT_UNION_FIND_HPP
+#define CONCURRENT_UNION_FIND_HPP
+
+// Lock-free disjoint sets for many threads at once (Anderson & Woll, Jayanti & Tarjan). Every vertex holds an atomic
+// parent; a root points to itself.
+//
+//   find(v)        - path splitting: while walking up, every visited vertex is CAS'ed from its parent to its grandparent.
+//                    A failed CAS only means another thread already shortened the path, nothing is retried.
+//   unite(u, v)    - find both roots, link the root of lower priority below the other with one CAS on its parent,
+//                    which succeeds only if it is still a root. If not, somebody linked it meanwhile: search again.
+//   same_set(u, v) - roots of u and v equal: true. Different: the answer is "no" only if u's root is still a root after
+//                    v's root was found, otherwise the sets may have just been joined and the query repeats.
+//
+// Priorities are a hash of the vertex id (ties by id), which is randomized linking: trees have O(log V) expected height
+// for any order of unions, without a rank field which would have to be updated together with the parent.
+// Nothing blocks, a thread which stalls holds up nobody. Sequential union-find is in spanning_tree.h.
+//
+// connected_components() runs unite() over all edges of a CSR_Graph on a Thread_Pool, then names components 0..k-1
+// in the order of their smallest vertex.
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "csr_graph.h"
+#include "thread_pool.h"
+
+class Concurrent_Union_Find
+{
+    private:
+    uint32_t vertices;
+    std::unique_ptr<std::atomic<uint32_t>[]> parent;
+
+    static uint32_t priority(uint32_t v)
+    {
+        uint64_t z = (uint64_t(v) + 1) * 0x9e3779b97f4a7c15ull;
+        return uint32_t((z ^ (z >> 29)) >> 32);
+    }
+    static bool lower(uint32_t u, uint32_t v) { return priority(u) < priority(v) || (priority(u) == priority(v) && u < v); }
+
+    public:
+    explicit Concurrent_Union_Find(uint32_t vertices_) : vertices(vertices_), parent(new std::atomic<uint32_t>[vertices_])
+    {
+        for (uint32_t v = 0; v < vertices; v++) { parent[v].store(v, std::memory_order_relaxed); }
+    }
+
+    uint32_t size() const { return vertices; }
+
+    uint32_t find(uint32_t v)
+    {
+        while (true)
+        {
+            uint32_t up = parent[v].load(std::memory_order_acquire);
+            uint32_t grand = parent[up].load(std::memory_order_acquire);
+            if (up == grand) { return up; }
+            parent[v].compare_exchange_weak(up, grand, std::memory_order_acq_rel, std::memory_order_relaxed);
+            v = up;
+        }
+    }
+
+    // false if u and v already were in one set.
+    bool unite(uint32_t u, uint32_t v)
+    {
+        while (true)
+        {
+            u = find(u);
+            v = find(v);
+            if (u == v) { return false; }
+            if (lower(v, u)) { std::swap(u, v); }
+            uint32_t expected = u;
+            if (parent[u].compare_exchange_strong(expected, v, std::memory_order_acq_rel)) { return true; }
+        }
+    }
+
+    bool same_set(uint32_t u, uint32_t v)
+    {
+        while (true)
+        {
+            u = find(u);
+            v = find(v);
+            if (u == v) { return true; }
+            if (parent[u].load(std::memory_order_seq_cst) == u) { return false; }
+        }
+    }
+
+    bool is_root(uint32_t v) const { return parent[v].load(std::memory_order_acquire) == v; }
+};
+
+// component[v] in 0..count-1, components numbered by their smallest vertex. A union does not care about the direction
+// of the edge, so a directed graph gives its weakly connected components.
+inline uint32_t connected_components(const CSR_Graph& graph, Thread_Pool& pool, std::vector<uint32_t>& component)
+{
+    uint32_t n = graph.vertex_count();
+    Concurrent_Union_Find sets(n);
+    pool.parallel_for(0, n, [&](uint64_t u, int) {
+        for (uint32_t v : graph.neighbours(uint32_t(u))) { if (v != u) { sets.unite(uint32_t(u), v); } }
+    }, 256);
+
+    component.resize(n);
+    pool.parallel_for(0, n, [&](uint64_t v, int) { component[v] = sets.find(uint32_t(v)); }, 4096);
+    // Roots become dense names in the order their components are first met.
+    std::vector<uint32_t> name(n, UINT32_MAX);
+    uint32_t count = 0;
+    for (uint32_t v = 0; v < n; v++)
+    {
+        uint32_t& root_name = name[component[v]];
+        if (root_name == UINT32_MAX) { root_name = count++; }
+        component[v] = root_name;
+    }
+    return count;
+}
+
+#endif // CONCURRENT_UNION_FIND_HPP
@@ -0,0 +1,75 @@
+// Parallel connected components with Concurrent_Union_Find:
+//   ./connected_components graph.csr          - a binary graph of graph_io.h (weakly connected components if directed)
+//   ./connected_components [vertices] [edges] - a random graph, checked against a sequential BFS labelling
+// Reports the number of components, the largest one, and the time for 1 thread and for the whole pool.
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include "csr_graph.h"
+#include "concurrent_union_find.h"
+#include "graph_generators.h"
+#include "graph_io.h"
+#include "thread_pool.h"
+#include "timing.h"
+
+// Components by BFS over the undirected graph, numbered in the order of their smallest vertex.
+uint32_t bfs_components(const CSR_Graph& graph, std::vector<uint32_t>& component)
+{
+    component.assign(graph.vertex_count(), UINT32_MAX);
+    std::vector<uint32_t> queue;
+    uint32_t count = 0;
+    for (uint32_t root = 0; root < graph.vertex_count(); root++)
+    {
+        if (component[root] != UINT32_MAX) { continue; }
+        component[root] = count;
+        queue.assign(1, root);
+        for (size_t head = 0; head < queue.size(); head++)
+        {
+            for (uint32_t v : graph.neighbours(queue[head]))
+            {
+                if (component[v] == UINT32_MAX) { component[v] = count; queue.push_back(v); }
+            }
+        }
+        count++;
+    }
+    return count;
+}
+
+int main(int argc, char* argv[])
+{
+    Thread_Pool pool;
+    CSR_Graph graph;
+    bool check = argc < 2 || std::string(argv[1]).find(".csr") == std::string::npos;
+    if (!check) { graph = map_binary_graph(argv[1]); }
+    else
+    {
+        uint32_t vertices = argc > 1 ? std::atoi(argv[1]) : 10000000;
+        uint64_t edge_count = argc > 2 ? std::atoll(argv[2]) : 6000000;
+        graph = generate_graph(Erdos_Renyi_Generator(vertices, edge_count, 42), pool, true, false);
+    }
+    std::cout << "Vertices: " << graph.vertex_count() << "\tEdges: " << graph.edge_count() << std::endl;
+
+    std::vector<uint32_t> component;
+    uint32_t count = 0;
+    Thread_Pool single(1);
+    double seconds = measure([&]() { count = connected_components(graph, single, component); });
+    std::cout << "Union-find, 1 thread:\t" << seconds << " s" << std::endl;
+    seconds = measure([&]() { count = connected_components(graph, pool, component); });
+    std::cout << "Union-find, " << pool.size() << " threads:\t" << seconds << " s" << std::endl;
+
+    std::vector<uint64_t> sizes(count, 0);
+    for (uint32_t c : component) { sizes[c]++; }
+    std::cout << "Components: " << count << "\tlargest: " << (count ? *std::max_element(sizes.begin(), sizes.end()) : 0) << std::endl;
+
+    if (check)
+    {
+        std::vector<uint32_t> expected;
+        uint32_t expected_count = 0;
+        seconds = measure([&]() { expected_count = bfs_components(graph, expected); });
+        std::cout << "Sequential BFS:\t\t" << seconds << " s" << (expected_count == count && expected == component ? "" : "\tMISMATCH") << std::endl;
+    }
+    return 0;
+}
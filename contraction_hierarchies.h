@@ -0,0 +1,351 @@
+#ifndef CONTRACTION_HIERARCHIES_HPP
+#define CONTRACTION_HIERARCHIES_HPP
+
+// Contraction Hierarchies (Geisberger et al.): preprocessing once makes point-to-point queries on a static graph
+// settle a few hundred vertices instead of a big part of the graph.
+//
+// Preprocessing contracts vertices one after another from the least to the most important. Contracting v removes it
+// and keeps every distance between the remaining vertices: for each pair u -> v -> w a shortcut u -> w (middle v) is added
+// unless a witness search finds a path u ~> w avoiding v which is not longer:
+//
+//     u --3--> v --4--> w        contract v,  no witness  ->   u --7--> w  (shortcut, middle v)
+//
+// Order: vertices with the smallest edge difference (shortcuts added - edges removed) plus the number of already
+// contracted neighbours plus the level (depth of the hierarchy below the vertex) go first. Every round takes all remaining vertices whose priority is smaller than the priority
+// of each remaining neighbour. They are independent, so their witness searches run in parallel on a Thread_Pool,
+// shortcuts are applied afterwards and priorities of their neighbours are recomputed in parallel again.
+// Ranks of the round are handed out before its witness searches, and a witness of v passes only through vertices ranked
+// above v, exactly as if the round were contracted one by one. Two vertices can not be each other's witness and both vanish.
+// A witness search settles at most witness_limit vertices; when it gives up, the shortcut is added (never wrong, only bigger).
+//
+// The rank of a vertex is its position in the contraction order. Every edge (original or shortcut) goes
+// from the lower to the higher ranked end into one of two CSR search graphs:
+//   upward   - v -> x with rank[x] > rank[v], for the forward search from start,
+//   downward - v -> x with rank[x] > rank[v] for an edge x -> v, for the backward search from end.
+// Query: Dijkstra upward from start and upward (over downward) from end; the shortest path goes up and then down,
+// the searches meet at its highest vertex. Shortcuts on the found path are unpacked through their middle vertices into
+// the same vertex chain which extract_path() gives after dijkstra().
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "csr_graph.h"
+#include "priority_queue.h"
+#include "shortest_paths.h"
+#include "thread_pool.h"
+#include "traversal_workspace.h"
+
+class Contraction_Hierarchy
+{
+    public:
+    static constexpr uint32_t NO_MIDDLE = UINT32_MAX;
+
+    private:
+    struct Arc
+    {
+        uint32_t vertex;
+        unsigned int weight;
+        uint32_t middle;
+    };
+
+    struct Shortcut
+    {
+        uint32_t from;
+        uint32_t to;
+        unsigned int weight;
+    };
+
+    uint32_t V;
+    std::vector<uint32_t> rank;
+    CSR_Graph upward;
+    CSR_Graph downward;
+    std::vector<uint32_t> upward_middle;   // Parallel to the edges of upward, NO_MIDDLE for original edges.
+    std::vector<uint32_t> downward_middle;
+    uint64_t shortcuts = 0;
+
+    // Keeps only the lightest of parallel arcs.
+    static void add_arc(std::vector<Arc>& arcs, uint32_t vertex, unsigned int weight, uint32_t middle)
+    {
+        for (Arc& arc : arcs)
+        {
+            if (arc.vertex == vertex)
+            {
+                if (weight < arc.weight) { arc.weight = weight; arc.middle = middle; }
+                return;
+            }
+        }
+        arcs.push_back(Arc{vertex, weight, middle});
+    }
+
+    static void remove_arc(std::vector<Arc>& arcs, uint32_t vertex)
+    {
+        arcs.erase(std::remove_if(arcs.begin(), arcs.end(), [&](const Arc& arc) { return arc.vertex == vertex; }), arcs.end());
+    }
+
+    // Shortcuts needed to contract v in the remaining graph given by out / in, witnesses avoid vertices ranked below v. Only reads.
+    static void find_shortcuts(uint32_t v, const std::vector<std::vector<Arc>>& out, const std::vector<std::vector<Arc>>& in,
+                               const std::vector<uint32_t>& rank, uint32_t witness_limit, Traversal_Workspace& workspace,
+                               Priority_Queue<Heap_Entry>& min_heap, std::vector<Shortcut>& result)
+    {
+        result.clear();
+        if (in[v].empty() || out[v].empty()) { return; }
+        unsigned int longest_out = 0;
+        for (const Arc& arc : out[v]) { longest_out = std::max(longest_out, arc.weight); }
+
+        for (const Arc& first : in[v])
+        {
+            uint32_t u = first.vertex;
+            unsigned int limit = first.weight + longest_out;
+
+            workspace.begin(uint32_t(out.size()));
+            workspace.visit(u);
+            workspace.set_distance(u, 0);
+            min_heap.clear();
+            min_heap.insert(Heap_Entry{int(u), 0});
+            uint32_t settled = 0, targets_left = uint32_t(out[v].size());
+            while (!min_heap.is_empty() && settled < witness_limit)
+            {
+                Heap_Entry current = min_heap.min_peek();
+                min_heap.extract_peek();
+                if (current.distance > workspace.distance(current.vertex_id)) { continue; }
+                if (current.distance > limit) { break; }
+                for (const Arc& target : out[v]) { targets_left -= target.vertex == uint32_t(current.vertex_id); }
+                if (targets_left == 0) { break; } // Every possible shortcut is decided.
+                settled++;
+                for (const Arc& arc : out[current.vertex_id])
+                {
+                    if (arc.vertex == v || rank[arc.vertex] < rank[v]) { continue; }
+                    unsigned int candidate = current.distance + arc.weight;
+                    if (!workspace.is_visited(arc.vertex)) { workspace.visit(arc.vertex); }
+                    if (candidate < workspace.distance(arc.vertex))
+                    {
+                        workspace.set_distance(arc.vertex, candidate);
+                        min_heap.insert(Heap_Entry{int(arc.vertex), candidate});
+                    }
+                }
+            }
+
+            for (const Arc& second : out[v])
+            {
+                uint32_t w = second.vertex;
+                if (w == u) { continue; }
+                if (workspace.distance(w) > first.weight + second.weight) { result.push_back(Shortcut{u, w, first.weight + second.weight}); }
+            }
+        }
+    }
+
+    // Middle vertex of the hierarchy edge a -> b (in the direction of the original graph).
+    uint32_t middle(uint32_t a, uint32_t b) const
+    {
+        if (rank[a] < rank[b])
+        {
+            for (uint64_t edge = upward.first_edge(a); edge < upward.last_edge(a); edge++)
+            {
+                if (upward.target(edge) == b) { return upward_middle[edge]; }
+            }
+        }
+        else
+        {
+            for (uint64_t edge = downward.first_edge(b); edge < downward.last_edge(b); edge++)
+            {
+                if (downward.target(edge) == a) { return downward_middle[edge]; }
+            }
+        }
+        return NO_MIDDLE;
+    }
+
+    // Appends the original vertices after a up to and including b.
+    void unpack_edge(uint32_t a, uint32_t b, std::vector<uint32_t>& path) const
+    {
+        std::vector<std::pair<uint32_t, uint32_t>> stack{{a, b}};
+        while (!stack.empty())
+        {
+            std::pair<uint32_t, uint32_t> edge = stack.back();
+            stack.pop_back();
+            uint32_t m = middle(edge.first, edge.second);
+            if (m == NO_MIDDLE) { path.push_back(edge.second); continue; }
+            stack.push_back({m, edge.second});
+            stack.push_back({edge.first, m});
+        }
+    }
+
+    public:
+    // Weights must be non-negative.
+    Contraction_Hierarchy(const CSR_Graph& graph, Thread_Pool& pool, uint32_t witness_limit = 500)
+        : V(graph.vertex_count()), rank(graph.vertex_count(), UINT32_MAX)
+    {
+        std::vector<std::vector<Arc>> out(V), in(V);
+        for (uint32_t u = 0; u < V; u++)
+        {
+            for (uint64_t edge = graph.first_edge(u); edge < graph.last_edge(u); edge++)
+            {
+                uint32_t v = graph.target(edge);
+                if (u == v) { continue; }
+                add_arc(out[u], v, graph.weight(edge), NO_MIDDLE);
+                add_arc(in[v], u, graph.weight(edge), NO_MIDDLE);
+            }
+        }
+
+        std::vector<std::vector<Shortcut>> found(pool.size());
+        std::vector<Traversal_Workspace> workspaces(pool.size());
+        std::vector<Priority_Queue<Heap_Entry>> heaps(pool.size()); // Witness search heaps, one per thread like the workspaces.
+        std::vector<int64_t> priority(V);
+        std::vector<uint32_t> contracted_neighbours(V, 0), level(V, 0);
+        std::vector<char> is_selected(V, 0);
+        auto update_priority = [&](uint32_t v, int thread_index) {
+            find_shortcuts(v, out, in, rank, witness_limit, workspaces[thread_index], heaps[thread_index], found[thread_index]);
+            priority[v] = int64_t(found[thread_index].size()) - int64_t(in[v].size() + out[v].size()) + contracted_neighbours[v] + level[v];
+        };
+        pool.parallel_for(0, V, [&](uint64_t v, int thread_index) { update_priority(uint32_t(v), thread_index); }, 64);
+
+        // Edges of a vertex towards higher ranks, collected when it is contracted.
+        std::vector<std::vector<Arc>> up(V), down(V);
+        std::vector<uint32_t> remaining(V), selected, neighbours, neighbour_stamp(V, UINT32_MAX);
+        for (uint32_t v = 0; v < V; v++) { remaining[v] = v; }
+        std::vector<std::vector<Shortcut>> round_shortcuts;
+        uint32_t next_rank = 0, round = 0;
+
+        while (!remaining.empty())
+        {
+            auto before = [&](uint32_t a, uint32_t b) { return priority[a] < priority[b] || (priority[a] == priority[b] && a < b); };
+            pool.parallel_for(0, remaining.size(), [&](uint64_t index, int) {
+                uint32_t v = remaining[index];
+                bool minimum = true;
+                for (const Arc& arc : out[v]) { minimum &= before(v, arc.vertex); }
+                for (const Arc& arc : in[v]) { minimum &= before(v, arc.vertex); }
+                is_selected[v] = minimum;
+            });
+            selected.clear();
+            for (uint32_t v : remaining) { if (is_selected[v]) { rank[v] = next_rank++; selected.push_back(v); } }
+
+            round_shortcuts.resize(selected.size());
+            pool.parallel_for(0, selected.size(), [&](uint64_t index, int thread_index) {
+                find_shortcuts(selected[index], out, in, rank, witness_limit, workspaces[thread_index], heaps[thread_index], round_shortcuts[index]);
+            }, 16);
+
+            neighbours.clear();
+            for (size_t index = 0; index < selected.size(); index++)
+            {
+                uint32_t v = selected[index];
+                up[v] = std::move(out[v]);
+                down[v] = std::move(in[v]);
+                out[v].clear();
+                in[v].clear();
+                for (const Arc& arc : up[v]) { remove_arc(in[arc.vertex], v); }
+                for (const Arc& arc : down[v]) { remove_arc(out[arc.vertex], v); }
+                for (const Shortcut& shortcut : round_shortcuts[index])
+                {
+                    add_arc(out[shortcut.from], shortcut.to, shortcut.weight, v);
+                    add_arc(in[shortcut.to], shortcut.from, shortcut.weight, v);
+                }
+                shortcuts += round_shortcuts[index].size();
+                for (const std::vector<Arc>* arcs : {&up[v], &down[v]})
+                {
+                    for (const Arc& arc : *arcs)
+                    {
+                        if (neighbour_stamp[arc.vertex] != round) { neighbour_stamp[arc.vertex] = round; neighbours.push_back(arc.vertex); }
+                        contracted_neighbours[arc.vertex]++;
+                        level[arc.vertex] = std::max(level[arc.vertex], level[v] + 1);
+                    }
+                }
+            }
+            remaining.erase(std::remove_if(remaining.begin(), remaining.end(), [&](uint32_t v) { return is_selected[v]; }), remaining.end());
+            pool.parallel_for(0, neighbours.size(), [&](uint64_t index, int thread_index) {
+                update_priority(neighbours[index], thread_index);
+            }, 16);
+            round++;
+        }
+
+        std::vector<CSR_Edge> edges;
+        for (uint32_t v = 0; v < V; v++)
+        {
+            for (const Arc& arc : up[v]) { edges.emplace_back(v, arc.vertex, arc.weight); upward_middle.push_back(arc.middle); }
+        }
+        upward = CSR_Graph::from_edges(V, edges);
+        edges.clear();
+        for (uint32_t v = 0; v < V; v++)
+        {
+            for (const Arc& arc : down[v]) { edges.emplace_back(v, arc.vertex, arc.weight); downward_middle.push_back(arc.middle); }
+        }
+        downward = CSR_Graph::from_edges(V, edges);
+    }
+
+    uint32_t vertex_count() const { return V; }
+    uint32_t get_rank(uint32_t v) const { return rank[v]; }
+    uint64_t shortcut_count() const { return shortcuts; }
+    uint64_t edge_count() const { return upward.edge_count() + downward.edge_count(); }
+
+    // Search graphs for engines built on top of the hierarchy, e.g. the bucket-based many-to-many in distance_matrix.h.
+    const CSR_Graph& upward_graph() const { return upward; }
+    const CSR_Graph& downward_graph() const { return downward; }
+
+    // Distances in forward / backward are the ones inside the hierarchy, valid only along the found path.
+    Bidirectional_Result query(uint32_t start, uint32_t end, Traversal_Workspace& forward, Traversal_Workspace& backward) const
+    {
+        const CSR_Graph* graphs[2] = {&upward, &downward};
+        Traversal_Workspace* workspaces[2] = {&forward, &backward};
+        Priority_Queue<Heap_Entry> heaps[2];
+        uint32_t sources[2] = {start, end};
+        for (int side = 0; side < 2; side++)
+        {
+            workspaces[side]->begin(V);
+            workspaces[side]->visit(sources[side]);
+            workspaces[side]->set_distance(sources[side], 0);
+            heaps[side].insert(Heap_Entry{int(sources[side]), 0});
+        }
+
+        Bidirectional_Result result{Traversal_Workspace::INF, -1, 0};
+        while (!heaps[0].is_empty() || !heaps[1].is_empty())
+        {
+            int side = heaps[1].is_empty() || (!heaps[0].is_empty() && heaps[0].min_peek().distance <= heaps[1].min_peek().distance) ? 0 : 1;
+            if (heaps[side].min_peek().distance >= result.distance) { break; } // The other side is not below it either.
+
+            Traversal_Workspace& self = *workspaces[side];
+            const Traversal_Workspace& other = *workspaces[1 - side];
+            Heap_Entry current = heaps[side].min_peek();
+            heaps[side].extract_peek();
+
+            uint32_t u = current.vertex_id;
+            if (current.distance > self.distance(u) || self.is_finished(u)) { continue; }
+            self.finish(u);
+            result.settled++;
+            if (other.distance(u) != Traversal_Workspace::INF && uint64_t(current.distance) + other.distance(u) < result.distance)
+            {
+                result.distance = current.distance + other.distance(u);
+                result.meeting_vertex = u;
+            }
+
+            for (uint64_t edge = graphs[side]->first_edge(u); edge < graphs[side]->last_edge(u); ++edge)
+            {
+                uint32_t v = graphs[side]->target(edge);
+                unsigned int candidate = current.distance + graphs[side]->weight(edge);
+                if (!self.is_visited(v)) { self.visit(v); }
+                if (candidate < self.distance(v))
+                {
+                    self.set_distance(v, candidate);
+                    self.set_parent(v, u);
+                    heaps[side].insert(Heap_Entry{int(v), candidate});
+                }
+            }
+        }
+        return result;
+    }
+
+    // Path start -> ... -> end in the original graph, empty if end is unreachable.
+    std::vector<uint32_t> unpack_path(const Traversal_Workspace& forward, const Traversal_Workspace& backward,
+                                      const Bidirectional_Result& result) const
+    {
+        std::vector<uint32_t> path;
+        if (result.meeting_vertex == -1) { return path; }
+        std::vector<uint32_t> up_chain = extract_path(forward, result.meeting_vertex);
+        path.push_back(up_chain.front());
+        for (size_t i = 0; i + 1 < up_chain.size(); i++) { unpack_edge(up_chain[i], up_chain[i + 1], path); }
+        for (int v = result.meeting_vertex, next = backward.parent(v); next != -1; v = next, next = backward.parent(v))
+        {
+            unpack_edge(v, next, path);
+        }
+        return path;
+    }
+};
+
+#endif // CONTRACTION_HIERARCHIES_HPP
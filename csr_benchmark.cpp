@@ -0,0 +1,174 @@
+// Benchmark: the per-vertex std::vector<Edge> layout used by dijkstra.cpp / prim_algorithm.cpp versus the shared CSR_Graph.
+// The same random directed graph is stored both ways, then BFS and Dijkstra run over each of them.
+// Memory of the vector layout is estimated as vector headers + capacity + one allocator header (16 bytes) per vertex.
+// Usage: ./csr_benchmark [vertices] [edges]
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <random>
+#include <limits>
+#include <cstdlib>
+#include "csr_graph.h"
+#include "priority_queue.h"
+#include "timing.h"
+
+constexpr unsigned int INF = std::numeric_limits<unsigned int>::max();
+
+// 12 bytes, the source id is redundant: it is already known from the vertex which owns the vector.
+struct Edge {
+    public:
+    int vertex_source;
+    int vertex_destination;
+    int weight;
+    Edge(int vrtx_s, int vrtx_d, int weight_) : vertex_source(vrtx_s), vertex_destination(vrtx_d), weight(weight_) {}
+};
+
+using Vector_Graph = std::vector<std::vector<Edge>>;
+
+struct Heap_Entry {
+    public:
+    int vertex_id;
+    unsigned int distance;
+    Heap_Entry() : vertex_id(-1), distance(INF) {}
+    Heap_Entry(int vrtx_id, unsigned int distance_) : vertex_id(vrtx_id), distance(distance_) {}
+    bool operator<(const Heap_Entry& other) const { return this->distance < other.distance; }
+};
+
+std::vector<int> bfs(const Vector_Graph& graph, int start)
+{
+    std::vector<int> depth(graph.size(), -1);
+    std::queue<int> q;
+    q.push(start);
+    depth[start] = 0;
+    while (!q.empty())
+    {
+        int u = q.front();
+        q.pop();
+        for (const Edge& edge : graph[u])
+        {
+            if (depth[edge.vertex_destination] == -1)
+            {
+                depth[edge.vertex_destination] = depth[u] + 1;
+                q.push(edge.vertex_destination);
+            }
+        }
+    }
+    return depth;
+}
+
+std::vector<int> bfs(const CSR_Graph& graph, int start)
+{
+    std::vector<int> depth(graph.vertex_count(), -1);
+    std::queue<int> q;
+    q.push(start);
+    depth[start] = 0;
+    while (!q.empty())
+    {
+        int u = q.front();
+        q.pop();
+        for (uint32_t v : graph.neighbours(u))
+        {
+            if (depth[v] == -1)
+            {
+                depth[v] = depth[u] + 1;
+                q.push(v);
+            }
+        }
+    }
+    return depth;
+}
+
+std::vector<unsigned int> dijkstra(const Vector_Graph& graph, int start)
+{
+    std::vector<unsigned int> distances(graph.size(), INF);
+    distances[start] = 0;
+    Priority_Queue<Heap_Entry> min_heap;
+    min_heap.insert(Heap_Entry{start, 0});
+    while (!min_heap.is_empty())
+    {
+        Heap_Entry current = min_heap.min_peek();
+        min_heap.extract_peek();
+        int u = current.vertex_id;
+        if (current.distance > distances[u]) { continue; }
+        for (const Edge& edge : graph[u])
+        {
+            int v = edge.vertex_destination;
+            if (distances[u] + edge.weight < distances[v])
+            {
+                distances[v] = distances[u] + edge.weight;
+                min_heap.insert(Heap_Entry{v, distances[v]});
+            }
+        }
+    }
+    return distances;
+}
+
+std::vector<unsigned int> dijkstra(const CSR_Graph& graph, int start)
+{
+    std::vector<unsigned int> distances(graph.vertex_count(), INF);
+    distances[start] = 0;
+    Priority_Queue<Heap_Entry> min_heap;
+    min_heap.insert(Heap_Entry{start, 0});
+    while (!min_heap.is_empty())
+    {
+        Heap_Entry current = min_heap.min_peek();
+        min_heap.extract_peek();
+        int u = current.vertex_id;
+        if (current.distance > distances[u]) { continue; }
+        for (uint64_t edge = graph.first_edge(u); edge < graph.last_edge(u); ++edge)
+        {
+            uint32_t v = graph.target(edge);
+            if (distances[u] + graph.weight(edge) < distances[v])
+            {
+                distances[v] = distances[u] + graph.weight(edge);
+                min_heap.insert(Heap_Entry{int(v), distances[v]});
+            }
+        }
+    }
+    return distances;
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t vertices = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    uint64_t edge_count = argc > 2 ? std::atoll(argv[2]) : 10000000;
+
+    std::vector<CSR_Edge> edges(edge_count);
+    std::mt19937 rng(42);
+    for (auto& edge : edges)
+    {
+        edge = CSR_Edge(rng() % vertices, rng() % vertices, 1 + rng() % 100);
+    }
+    std::cout << "Vertices: " << vertices << "\tEdges: " << edge_count << std::endl;
+
+    Vector_Graph vector_graph;
+    double seconds = measure([&]() {
+        vector_graph.assign(vertices, {});
+        for (const auto& edge : edges) { vector_graph[edge.vertex_from].emplace_back(Edge(edge.vertex_from, edge.vertex_to, edge.weight)); }
+    });
+    uint64_t vector_bytes = vector_graph.size() * sizeof(std::vector<Edge>);
+    for (const auto& neighbours : vector_graph)
+    {
+        vector_bytes += neighbours.capacity() * sizeof(Edge) + (neighbours.capacity() > 0 ? 16 : 0);
+    }
+    std::cout << "Build vector layout:\t" << seconds << " s\t" << vector_bytes / 1e6 << " MB" << std::endl;
+
+    CSR_Graph csr_graph;
+    seconds = measure([&]() { csr_graph = CSR_Graph::from_edges(vertices, edges); });
+    std::cout << "Build CSR (counting sort):\t" << seconds << " s\t" << csr_graph.memory_bytes() / 1e6 << " MB" << std::endl;
+
+    std::vector<int> vector_depth, csr_depth;
+    double vector_seconds = measure([&]() { vector_depth = bfs(vector_graph, 0); });
+    double csr_seconds = measure([&]() { csr_depth = bfs(csr_graph, 0); });
+    std::cout << "BFS:\tvector " << vector_seconds << " s\tCSR " << csr_seconds << " s\tspeedup " << vector_seconds / csr_seconds
+              << (vector_depth == csr_depth ? "" : "\tMISMATCH") << std::endl;
+
+    std::vector<unsigned int> vector_distances, csr_distances;
+    vector_seconds = measure([&]() { vector_distances = dijkstra(vector_graph, 0); });
+    csr_seconds = measure([&]() { csr_distances = dijkstra(csr_graph, 0); });
+    std::cout << "Dijkstra:\tvector " << vector_seconds << " s\tCSR " << csr_seconds << " s\tspeedup " << vector_seconds / csr_seconds
+              << (vector_distances == csr_distances ? "" : "\tMISMATCH") << std::endl;
+
+    return 0;
+}
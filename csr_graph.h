@@ -0,0 +1,277 @@
+#ifndef CSR_GRAPH_HPP
+#define CSR_GRAPH_HPP
+
+// CSR (Compressed Sparse Row) is an immutable graph representation made of three flat arrays:
+// offsets - for every vertex v its outgoing edges occupy positions [offsets[v], offsets[v + 1]) of the arrays below.
+// targets - destination vertex of every edge.
+// weights - weight of every edge. It is a separate array (structure of arrays), empty for unweighted graphs,
+//           so traversals which do not need weights never load them.
+//
+//      0 -> 1 (10), 0 -> 3 (30), 1 -> 2 (50), 3 -> 2 (20)
+//
+//      offsets: [0, 2, 3, 3, 4]        vertex v: targets[offsets[v] .. offsets[v + 1])
+//      targets: [1, 3, 2, 2]
+//      weights: [10, 30, 50, 20]
+//
+// Compared to std::vector<std::vector<Edge>>: no heap allocation per vertex, no 24-byte vector header per vertex,
+// no redundant source id inside every edge, and neighbours of consecutive vertices are consecutive in memory.
+// Graph is built from an edge list with a counting sort: count degrees, prefix sums, scatter. O(V + E).
+//
+// The arrays are read through pointers. A graph built here owns them (vectors inside the object); a view made by
+// CSR_Graph::view() points into memory owned by somebody else, e.g. a memory-mapped file (graph_io.h), and keeps
+// that owner alive through a shared_ptr. Copies of a view are views of the same memory.
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+struct CSR_Edge
+{
+    public:
+    uint32_t vertex_from;
+    uint32_t vertex_to;
+    int32_t weight;
+    CSR_Edge() : vertex_from(0), vertex_to(0), weight(1) {}
+    CSR_Edge(uint32_t vrtx_from, uint32_t vrtx_to, int32_t weight_ = 1) : vertex_from(vrtx_from), vertex_to(vrtx_to), weight(weight_) {}
+};
+
+class CSR_Graph
+{
+    public:
+    // Lightweight view of a contiguous part of one of the arrays: for (uint32_t v : graph.neighbours(u)) {...}
+    template <typename T>
+    struct Range
+    {
+        const T* first;
+        const T* last;
+        const T* begin() const { return first; }
+        const T* end() const { return last; }
+        uint64_t size() const { return last - first; }
+        const T& operator[](uint64_t index) const { return first[index]; }
+    };
+
+    // Target and weight together: for (auto edge : graph.edges(u)) { edge.target, edge.weight }. Weight 1 if unweighted.
+    struct Weighted_Neighbour
+    {
+        uint32_t target;
+        int32_t weight;
+    };
+
+    class Edge_Iterator
+    {
+        private:
+        const uint32_t* target;
+        const int32_t* weight; // nullptr for unweighted graphs.
+
+        public:
+        Edge_Iterator(const uint32_t* target_, const int32_t* weight_) : target(target_), weight(weight_) {}
+        Weighted_Neighbour operator*() const { return {*target, weight ? *weight : 1}; }
+        Edge_Iterator& operator++() { target++; if (weight) { weight++; } return *this; }
+        bool operator!=(const Edge_Iterator& other) const { return target != other.target; }
+    };
+
+    struct Edge_Range
+    {
+        Edge_Iterator first;
+        Edge_Iterator last;
+        Edge_Iterator begin() const { return first; }
+        Edge_Iterator end() const { return last; }
+    };
+
+    private:
+    uint32_t V;
+    uint64_t E;
+    const uint64_t* offsets;
+    const uint32_t* targets;
+    const int32_t* weights; // nullptr for unweighted graphs.
+
+    std::vector<uint64_t> offset_storage;
+    std::vector<uint32_t> target_storage;
+    std::vector<int32_t> weight_storage;
+    std::shared_ptr<const void> owner; // Set only for views.
+    static constexpr uint64_t no_offsets[1] = {0}; // Offsets of a moved-from graph, so moving never allocates.
+
+    void point_to_storage()
+    {
+        offsets = offset_storage.empty() ? no_offsets : offset_storage.data();
+        targets = target_storage.data();
+        weights = weight_storage.empty() ? nullptr : weight_storage.data();
+    }
+
+    void copy_from(const CSR_Graph& other)
+    {
+        V = other.V;
+        E = other.E;
+        offset_storage = other.offset_storage;
+        target_storage = other.target_storage;
+        weight_storage = other.weight_storage;
+        owner = other.owner;
+        if (owner) { offsets = other.offsets; targets = other.targets; weights = other.weights; }
+        else { point_to_storage(); }
+    }
+
+    void move_from(CSR_Graph& other) noexcept
+    {
+        V = other.V;
+        E = other.E;
+        offset_storage = std::move(other.offset_storage);
+        target_storage = std::move(other.target_storage);
+        weight_storage = std::move(other.weight_storage);
+        owner = std::move(other.owner);
+        if (owner) { offsets = other.offsets; targets = other.targets; weights = other.weights; }
+        else { point_to_storage(); }
+        other.V = 0;
+        other.E = 0;
+        other.offset_storage.clear();
+        other.target_storage.clear();
+        other.weight_storage.clear();
+        other.point_to_storage();
+    }
+
+    public:
+    CSR_Graph() : V(0), E(0), offset_storage(1, 0) { point_to_storage(); }
+    CSR_Graph(const CSR_Graph& other) { copy_from(other); }
+    CSR_Graph(CSR_Graph&& other) noexcept { move_from(other); }
+    CSR_Graph& operator=(const CSR_Graph& other) { if (this != &other) { copy_from(other); } return *this; }
+    CSR_Graph& operator=(CSR_Graph&& other) noexcept { if (this != &other) { move_from(other); } return *this; }
+
+    // Graph over arrays owned by owner (offsets has vertices + 1 entries, targets and weights offsets[vertices];
+    // weights may be nullptr). Nothing is copied.
+    static CSR_Graph view(uint32_t vertices, const uint64_t* offsets, const uint32_t* targets, const int32_t* weights,
+                          std::shared_ptr<const void> owner)
+    {
+        CSR_Graph graph;
+        graph.offset_storage.clear();
+        graph.V = vertices;
+        graph.E = offsets[vertices];
+        graph.offsets = offsets;
+        graph.targets = targets;
+        graph.weights = weights;
+        graph.owner = std::move(owner);
+        return graph;
+    }
+
+    // undirected - store every edge in both directions. weighted - keep the weights array.
+    // Edges of one vertex keep the order of the input list. Throws std::out_of_range for an endpoint >= vertices.
+    static CSR_Graph from_edges(uint32_t vertices, const std::vector<CSR_Edge>& edges, bool undirected = false, bool weighted = true)
+    {
+        CSR_Graph graph;
+        graph.V = vertices;
+        std::vector<uint64_t>& offsets = graph.offset_storage;
+        offsets.assign(uint64_t(vertices) + 1, 0);
+
+        for (const CSR_Edge& edge : edges)
+        {
+            if (edge.vertex_from >= vertices || edge.vertex_to >= vertices) { throw std::out_of_range("CSR_Graph: edge endpoint out of range"); }
+            offsets[edge.vertex_from + 1]++;
+            if (undirected) { offsets[edge.vertex_to + 1]++; }
+        }
+        for (uint32_t v = 0; v < vertices; v++) { offsets[v + 1] += offsets[v]; }
+
+        graph.E = offsets[vertices];
+        graph.target_storage.resize(graph.E);
+        if (weighted) { graph.weight_storage.resize(graph.E); }
+
+        std::vector<uint64_t> position(offsets.begin(), offsets.end() - 1);
+        auto place = [&](uint32_t from, uint32_t to, int32_t weight) {
+            uint64_t index = position[from]++;
+            graph.target_storage[index] = to;
+            if (weighted) { graph.weight_storage[index] = weight; }
+        };
+        for (const CSR_Edge& edge : edges)
+        {
+            place(edge.vertex_from, edge.vertex_to, edge.weight);
+            if (undirected) { place(edge.vertex_to, edge.vertex_from, edge.weight); }
+        }
+        graph.point_to_storage();
+        return graph;
+    }
+
+    uint32_t vertex_count() const { return V; }
+    uint64_t edge_count() const { return E; }
+    bool is_weighted() const { return weights != nullptr; }
+    bool is_view() const { return owner != nullptr; }
+
+    uint64_t first_edge(uint32_t v) const { return offsets[v]; }
+    uint64_t last_edge(uint32_t v) const { return offsets[v + 1]; }
+    uint32_t degree(uint32_t v) const { return uint32_t(offsets[v + 1] - offsets[v]); }
+
+    uint32_t target(uint64_t edge) const { return targets[edge]; }
+    int32_t weight(uint64_t edge) const { return weights ? weights[edge] : 1; }
+
+    Range<uint32_t> neighbours(uint32_t v) const { return {targets + offsets[v], targets + offsets[v + 1]}; }
+
+    // Parallel to neighbours(v). Valid only for weighted graphs.
+    Range<int32_t> neighbour_weights(uint32_t v) const { return {weights + offsets[v], weights + offsets[v + 1]}; }
+
+    Edge_Range edges(uint32_t v) const
+    {
+        return {{targets + offsets[v], weights ? weights + offsets[v] : nullptr}, {targets + offsets[v + 1], weights ? weights + offsets[v + 1] : nullptr}};
+    }
+
+    // Resumable scan of [first_edge(v), last_edge(v)) for engines which leave a list and come back to it (DFS).
+    // previous starts at 0; CSR does not need it, Compressed_Graph (compressed_graph.h) decodes gaps from it.
+    uint32_t next_neighbour(uint64_t& edge, uint32_t& /* previous */) const { return targets[edge++]; }
+
+    // Raw arrays, e.g. to write the graph to a file. weight_data() is nullptr for unweighted graphs.
+    const uint64_t* offset_data() const { return offsets; }
+    const uint32_t* target_data() const { return targets; }
+    const int32_t* weight_data() const { return weights; }
+
+    // The same graph with every edge turned around: out-neighbours of v here are in-neighbours of v in the original.
+    CSR_Graph reversed() const
+    {
+        std::vector<CSR_Edge> edges;
+        edges.reserve(edge_count());
+        for (uint32_t u = 0; u < V; u++)
+        {
+            for (uint64_t edge = offsets[u]; edge < offsets[u + 1]; edge++)
+            {
+                edges.emplace_back(CSR_Edge(targets[edge], u, weight(edge)));
+            }
+        }
+        return from_edges(V, edges, false, is_weighted());
+    }
+
+    // The same graph with vertex v renamed to new_id[v] (a permutation of 0..V-1), weights travel with their edges.
+    // Neighbour lists are sorted by the new ids, so a scan over them walks forward through per-vertex arrays.
+    CSR_Graph permuted(const std::vector<uint32_t>& new_id) const
+    {
+        CSR_Graph graph;
+        graph.V = V;
+        graph.E = E;
+        std::vector<uint32_t> old_id(V);
+        for (uint32_t v = 0; v < V; v++) { old_id[new_id[v]] = v; }
+        graph.offset_storage.assign(uint64_t(V) + 1, 0);
+        for (uint32_t v = 0; v < V; v++) { graph.offset_storage[v + 1] = graph.offset_storage[v] + degree(old_id[v]); }
+        graph.target_storage.resize(E);
+        if (weights) { graph.weight_storage.resize(E); }
+
+        std::vector<std::pair<uint32_t, int32_t>> list;
+        for (uint32_t v = 0; v < V; v++)
+        {
+            list.clear();
+            for (uint64_t edge = offsets[old_id[v]]; edge < offsets[old_id[v] + 1]; edge++) { list.emplace_back(new_id[targets[edge]], weight(edge)); }
+            std::sort(list.begin(), list.end());
+            uint64_t index = graph.offset_storage[v];
+            for (const auto& neighbour : list)
+            {
+                graph.target_storage[index] = neighbour.first;
+                if (weights) { graph.weight_storage[index] = neighbour.second; }
+                index++;
+            }
+        }
+        graph.point_to_storage();
+        return graph;
+    }
+
+    uint64_t memory_bytes() const
+    {
+        return (uint64_t(V) + 1) * sizeof(uint64_t) + E * sizeof(uint32_t) + (weights ? E * sizeof(int32_t) : 0);
+    }
+};
+
+#endif // CSR_GRAPH_HPP
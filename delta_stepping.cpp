@@ -0,0 +1,74 @@
+// Differential test and benchmark of Delta_Stepping against the sequential dijkstra() from shortest_paths.h
+// on a road-like graph: a width x height grid, every vertex linked to its right and lower neighbour, weights 1..1000.
+// Distances must be equal. Equally short paths may end in a different parent, so the parents of both are checked to be
+// shortest-path edges, and the parents of Delta_Stepping must be the smallest such predecessor of every vertex.
+// Then strong scaling for 1, 2, 4, ... threads up to all cores.
+// Usage: ./delta_stepping [width] [height] [delta]     (e.g. 7000 7000 for about 10^8 directed edges; delta 0 = automatic)
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <thread>
+#include "csr_graph.h"
+#include "shortest_paths.h"
+#include "timing.h"
+#include "traversal_workspace.h"
+#include "thread_pool.h"
+#include "delta_stepping.h"
+#include "graph_generators.h"
+
+int main(int argc, char* argv[])
+{
+    uint32_t width = argc > 1 ? std::atoi(argv[1]) : 1000;
+    uint32_t height = argc > 2 ? std::atoi(argv[2]) : 1000;
+    unsigned int delta = argc > 3 ? std::atoi(argv[3]) : 0;
+    uint32_t vertices = width * height;
+
+    CSR_Graph graph;
+    {
+        Thread_Pool pool;
+        graph = generate_graph(Grid_Generator(width, height, 42), pool, true);
+    }
+    std::cout << "Vertices: " << vertices << "\tDirected edges: " << graph.edge_count() << std::endl;
+
+    Traversal_Workspace workspace;
+    double seconds = measure([&]() { dijkstra(graph, 0, workspace); });
+    std::cout << "Sequential Dijkstra:\t" << seconds << " s" << std::endl;
+
+    // The smallest predecessor on a shortest path, the parent Delta_Stepping has to pick.
+    std::vector<int> smallest_parent(vertices, -1);
+    bool sequential_parents_valid = true;
+    for (uint32_t u = 0; u < vertices; u++)
+    {
+        for (uint64_t edge = graph.first_edge(u); edge < graph.last_edge(u); edge++)
+        {
+            uint32_t v = graph.target(edge);
+            bool tight = workspace.distance(u) != Traversal_Workspace::INF && workspace.distance(u) + graph.weight(edge) == workspace.distance(v);
+            if (tight && v != 0 && (smallest_parent[v] == -1 || int(u) < smallest_parent[v])) { smallest_parent[v] = u; }
+            if (workspace.parent(v) == int(u) && !tight) { sequential_parents_valid = false; }
+        }
+    }
+    if (!sequential_parents_valid) { std::cout << "Sequential parents are not shortest-path edges\tMISMATCH" << std::endl; }
+
+    int max_threads = std::max(1u, std::thread::hardware_concurrency());
+    double single_thread = 0;
+    std::vector<unsigned int> distances;
+    std::vector<int> parents;
+    for (int threads = 1; threads <= max_threads; threads = (threads * 2 > max_threads && threads < max_threads) ? max_threads : threads * 2)
+    {
+        Thread_Pool pool(threads);
+        Delta_Stepping delta_stepping(graph, pool, delta);
+        seconds = measure([&]() { delta_stepping.run(0, distances, parents); });
+        if (threads == 1) { single_thread = seconds; }
+
+        bool correct = true;
+        for (uint32_t v = 0; v < vertices; v++)
+        {
+            correct &= distances[v] == workspace.distance(v) && parents[v] == smallest_parent[v];
+        }
+        std::cout << "Delta-stepping, delta " << delta_stepping.get_delta() << ", threads: " << threads << "\t"
+                  << seconds << " s\tspeedup: " << single_thread / seconds << (correct ? "" : "\tMISMATCH") << std::endl;
+    }
+
+    return 0;
+}
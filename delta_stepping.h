@@ -0,0 +1,182 @@
+#ifndef DELTA_STEPPING_HPP
+#define DELTA_STEPPING_HPP
+
+// Delta-stepping single-source shortest paths (Meyer & Sanders).
+// Dijkstra settles vertices strictly one by one. Delta-stepping groups tentative distances into buckets of width delta:
+// bucket i holds vertices with distance in [i * delta, (i + 1) * delta). Every vertex of the current bucket is processed
+// at the same time, in parallel:
+//
+//     bucket:     0          1          2          3
+//              [0, d)    [d, 2d)   [2d, 3d)   [3d, 4d)
+//                 ^ current: relax light edges of all its vertices in parallel, repeat while the bucket refills,
+//                   then relax heavy edges of every vertex removed from it, once.
+//
+// Light edges (weight <= delta) may put a vertex back into the current bucket, so they are relaxed until the bucket
+// stays empty. Heavy edges (weight > delta) can only reach later buckets, one pass over them is enough.
+// Edges of every vertex are reordered once in the constructor: light ones first, heavy ones after light_end[v].
+//
+// Distance and parent are packed into one 64-bit word and improved with compare-and-swap on the pair (distance, parent).
+// Among equally short paths the smallest parent id wins, so parents do not depend on the number of threads or on timing.
+// Weights must be non-negative; with zero-weight cycles parents may form a cycle too, distances stay correct.
+// delta = 0 selects it automatically: max_weight / average_degree (the choice of the original paper, at least 1).
+// Buckets form a cyclic array: every tentative distance is below current distance + max_weight, so max_weight / delta + 2
+// slots hold all non-empty buckets, and bucket i lives in slot i % slots. Memory does not grow with the largest distance.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "csr_graph.h"
+#include "thread_pool.h"
+
+class Delta_Stepping
+{
+    public:
+    static constexpr unsigned int INF = std::numeric_limits<unsigned int>::max();
+
+    private:
+    const CSR_Graph& graph;
+    Thread_Pool& pool;
+    unsigned int delta;
+    size_t slots = 1; // Cyclic bucket array size.
+
+    // Edges of v: targets[graph.first_edge(v) .. light_end[v]) are light, [light_end[v] .. graph.last_edge(v)) are heavy.
+    std::vector<uint32_t> targets;
+    std::vector<int32_t> weights;
+    std::vector<uint64_t> light_end;
+
+    std::vector<std::atomic<uint64_t>> labels;
+    std::vector<uint32_t> frontier_stamp; // Deduplicates a vertex inside one frontier.
+    std::vector<uint32_t> settled_stamp;  // Deduplicates a vertex inside the set removed from the current bucket.
+
+    static uint64_t make_label(unsigned int distance, uint32_t parent) { return (uint64_t(distance) << 32) | parent; }
+    static unsigned int label_distance(uint64_t label) { return unsigned(label >> 32); }
+
+    // Returns true when the distance itself got shorter: only then the vertex has to be processed again.
+    bool relax(uint32_t v, unsigned int distance, uint32_t parent)
+    {
+        uint64_t candidate = make_label(distance, parent);
+        uint64_t current = labels[v].load(std::memory_order_relaxed);
+        while (candidate < current)
+        {
+            if (labels[v].compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+            {
+                return distance < label_distance(current);
+            }
+        }
+        return false;
+    }
+
+    public:
+    Delta_Stepping(const CSR_Graph& graph_, Thread_Pool& pool_, unsigned int delta_ = 0)
+        : graph(graph_), pool(pool_), delta(delta_), targets(graph_.edge_count()), weights(graph_.edge_count()),
+          light_end(graph_.vertex_count()), labels(graph_.vertex_count()),
+          frontier_stamp(graph_.vertex_count(), UINT32_MAX), settled_stamp(graph_.vertex_count(), UINT32_MAX)
+    {
+        int32_t max_weight = 1;
+        for (uint64_t edge = 0; edge < graph.edge_count(); edge++) { max_weight = std::max(max_weight, graph.weight(edge)); }
+        if (delta == 0)
+        {
+            double average_degree = graph.vertex_count() > 0 ? double(graph.edge_count()) / graph.vertex_count() : 1.0;
+            delta = std::max(1u, unsigned(max_weight / std::max(1.0, average_degree)));
+        }
+        slots = size_t(unsigned(max_weight) / delta) + 2;
+
+        pool.parallel_for(0, graph.vertex_count(), [&](uint64_t v, int) {
+            uint64_t light = graph.first_edge(v);
+            uint64_t heavy = graph.last_edge(v);
+            for (uint64_t edge = graph.first_edge(v); edge < graph.last_edge(v); edge++)
+            {
+                uint64_t position = unsigned(graph.weight(edge)) <= delta ? light++ : --heavy;
+                targets[position] = graph.target(edge);
+                weights[position] = graph.weight(edge);
+            }
+            light_end[v] = light;
+        });
+    }
+
+    unsigned int get_delta() const { return delta; }
+
+    void run(uint32_t source, std::vector<unsigned int>& distances, std::vector<int>& parents)
+    {
+        const uint32_t n = graph.vertex_count();
+        pool.parallel_for(0, n, [&](uint64_t v, int) { labels[v].store(make_label(INF, UINT32_MAX), std::memory_order_relaxed); });
+        std::fill(frontier_stamp.begin(), frontier_stamp.end(), UINT32_MAX);
+        std::fill(settled_stamp.begin(), settled_stamp.end(), UINT32_MAX);
+        labels[source].store(make_label(0, UINT32_MAX));
+
+        std::vector<std::vector<uint32_t>> buckets(slots);
+        buckets[0].push_back(source);
+        uint64_t queued = 1; // Entries in all buckets, stale copies included.
+        std::vector<std::vector<uint32_t>> updated(pool.size()); // Per-thread vertices whose distance got shorter.
+        std::vector<uint32_t> frontier, settled;
+        uint32_t phase = 0;
+
+        // Moves the vertices updated by the threads into their buckets. Stale copies are filtered when a bucket is taken.
+        auto distribute = [&]() {
+            for (auto& local : updated)
+            {
+                for (uint32_t v : local)
+                {
+                    size_t bucket = label_distance(labels[v].load(std::memory_order_relaxed)) / delta;
+                    buckets[bucket % slots].push_back(v);
+                }
+                queued += local.size();
+                local.clear();
+            }
+        };
+
+        auto relax_edges = [&](const std::vector<uint32_t>& vertices, bool light) {
+            pool.parallel_for(0, vertices.size(), [&](uint64_t index, int thread_index) {
+                uint32_t u = vertices[index];
+                unsigned int distance = label_distance(labels[u].load(std::memory_order_relaxed));
+                uint64_t first = light ? graph.first_edge(u) : light_end[u];
+                uint64_t last = light ? light_end[u] : graph.last_edge(u);
+                for (uint64_t edge = first; edge < last; edge++)
+                {
+                    if (relax(targets[edge], distance + weights[edge], u)) { updated[thread_index].push_back(targets[edge]); }
+                }
+            }, 64);
+        };
+
+        for (size_t current = 0; queued > 0; current++)
+        {
+            std::vector<uint32_t>& bucket = buckets[current % slots];
+            if (bucket.empty()) { continue; }
+            settled.clear();
+            while (!bucket.empty())
+            {
+                frontier.clear();
+                for (uint32_t v : bucket)
+                {
+                    bool belongs = label_distance(labels[v].load(std::memory_order_relaxed)) / delta == current;
+                    if (belongs && frontier_stamp[v] != phase)
+                    {
+                        frontier_stamp[v] = phase;
+                        frontier.push_back(v);
+                        if (settled_stamp[v] != current) { settled_stamp[v] = uint32_t(current); settled.push_back(v); }
+                    }
+                }
+                queued -= bucket.size();
+                bucket.clear();
+                phase++;
+
+                relax_edges(frontier, true);
+                distribute();
+            }
+            relax_edges(settled, false);
+            distribute();
+        }
+
+        distances.resize(n);
+        parents.resize(n);
+        pool.parallel_for(0, n, [&](uint64_t v, int) {
+            uint64_t label = labels[v].load(std::memory_order_relaxed);
+            distances[v] = label_distance(label);
+            parents[v] = uint32_t(label) == UINT32_MAX ? -1 : int(uint32_t(label));
+        });
+    }
+};
+
+#endif // DELTA_STEPPING_HPP
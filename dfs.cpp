@@ -6,6 +6,8 @@
 #include <iostream>
 #include <vector>
 #include <stack>
+#include "csr_graph.h"
+#include "dfs.h"
 
 struct Graph
 {
@@ -31,12 +33,16 @@ struct Graph
         std::vector<bool> is_visited(V,false); // [false,false,fale,false,false]
 
         stack.push(embarking_node);
-        is_visited[embarking_node] = true; // [true,false,fale,false,false]
 
         while (!stack.empty())
         {
             int value = stack.top(); 
             stack.pop();
+            // A vertex is marked when it is popped, not when it is pushed. Otherwise a vertex pushed early by a shallow
+            // neighbour would be blocked for a deeper path and the order would not be a real depth-first order.
+            // The price: the same vertex may sit in the stack several times, stale copies are skipped here.
+            if (is_visited[value]) { continue; }
+            is_visited[value] = true; // [true,false,fale,false,false]
             std::cout << value << "\t";
             // Check adjacency table for each node where neighbours of nodes are stored.
             // But in stack we would add them in the reverse order.
@@ -45,7 +51,6 @@ struct Graph
                 if (!is_visited[*it])
                 {
                     stack.push(*it);
-                    is_visited[*it] = true;
                 }
             }
         }
@@ -54,7 +59,17 @@ struct Graph
     }
 
     // Instance: start with vertex: 0
+    // Marks are reset on every call, so the search works more than once per Graph.
+    // Recursion depth equals the length of the longest path: for long chains use the explicit-stack engine from dfs.h.
     void depth_first_search_recursive(int embarking_node)
+    {
+        is_visited_recursive.assign(V,false);
+        visit_recursive(embarking_node);
+        std::cout << std::endl;
+    }
+
+    private:
+    void visit_recursive(int embarking_node)
     {
         std::cout << embarking_node << '\t';
 
@@ -64,7 +79,7 @@ struct Graph
         for (const auto& it : adjacency_table[embarking_node])
         {
             if (!is_visited_recursive[it])
-                depth_first_search_recursive(it);
+                visit_recursive(it);
         }
     }
 };
@@ -73,21 +88,53 @@ int main()
 {
     Graph graph(11); // From 0 to 10 inclusively
     
-    graph.make_bind(0,1);
-    graph.make_bind(0,2);
-    graph.make_bind(1,3);
-    graph.make_bind(1,4);
-    graph.make_bind(2,5);
-    graph.make_bind(2,6);
-    graph.make_bind(3,7);
-    graph.make_bind(4,8);
-    graph.make_bind(5,9);
-    graph.make_bind(6,10);
+    std::vector<CSR_Edge> binds = {{0,1},{0,2},{1,3},{1,4},{2,5},{2,6},{3,7},{4,8},{5,9},{6,10}};
+    for (const auto& bind : binds)
+    {
+        graph.make_bind(bind.vertex_from,bind.vertex_to);
+    }
 
     graph.depth_first_search(0);
 
     graph.depth_first_search_recursive(0);
 
+    CSR_Graph csr_graph = CSR_Graph::from_edges(11,binds,true,false);
+
+    // Explicit-stack engine with pre-order and post-order events.
+    struct Print_Visitor : DFS_Visitor
+    {
+        std::vector<uint32_t> pre_order, post_order;
+        void discover_vertex(uint32_t u) { pre_order.push_back(u); }
+        void finish_vertex(uint32_t u) { post_order.push_back(u); }
+    };
+    DFS_Workspace workspace;
+    workspace.reset(csr_graph.vertex_count());
+    Print_Visitor visitor;
+    depth_first_search(csr_graph,0,visitor,workspace);
+    std::cout << "Pre-order:\t";
+    for (uint32_t u : visitor.pre_order) { std::cout << u << '\t'; }
+    std::cout << "\nPost-order:\t";
+    for (uint32_t u : visitor.post_order) { std::cout << u << '\t'; }
+    std::cout << std::endl;
+
+    // Directed graph: 0 -> 1 -> 2 -> 0 is a cycle, 3 -> 4 -> 3 is another one, 2 -> 3 connects them.
+    CSR_Graph directed = CSR_Graph::from_edges(5,{{0,1},{1,2},{2,0},{2,3},{3,4},{4,3}},false,false);
+    std::vector<uint32_t> component;
+    uint32_t components = strongly_connected_components(directed,component,workspace);
+    std::cout << "Strongly connected components: " << components << "\t";
+    for (uint32_t v = 0; v < directed.vertex_count(); v++) { std::cout << v << ":" << component[v] << '\t'; }
+    std::cout << std::endl;
+
+    // A chain 0 -> 1 -> ... -> 10^7 - 1 would overflow the call stack of the recursive version.
+    const uint32_t chain_length = 10000000;
+    std::vector<CSR_Edge> chain;
+    for (uint32_t v = 0; v + 1 < chain_length; v++) { chain.emplace_back(v,v+1); }
+    CSR_Graph chain_graph = CSR_Graph::from_edges(chain_length,chain,false,false);
+    std::vector<uint32_t> order;
+    bool is_dag = topological_sort(chain_graph,order,workspace);
+    std::cout << "Chain of " << chain_length << " vertices: " << (is_dag ? "acyclic" : "cyclic")
+              << ", topological order starts with " << order[0] << " and ends with " << order.back() << std::endl;
+
     //          0            stack:     stack:     stack:    stack:     stack:    stack:    stack:      stack:   stack:     stack:
     //       /      \           
     //      1        2
@@ -0,0 +1,200 @@
+#ifndef DFS_HPP
+#define DFS_HPP
+
+// Stack-safe DFS engine over CSR_Graph. Recursion is replaced by an explicit stack of frames (vertex, next edge to look at),
+// so a chain of 10^8 vertices needs 10^8 frames in a heap-allocated vector instead of 10^8 frames of the call stack.
+// Frame keeps the position inside the neighbour list, therefore the order is exactly the one of the recursive DFS
+// and a vertex is finished only after all of its descendants.
+//
+// Events are delivered to a visitor (template parameter, so calls are inlined and unused events cost nothing):
+//   discover_vertex(u)           - u is entered (pre-order).
+//   tree_edge(u, v)              - v is discovered from u.
+//   back_edge(u, v)              - v is an ancestor of u which is still on the stack: the graph has a cycle.
+//   forward_or_cross_edge(u, v)  - v is already finished.
+//   finish_edge(u, v)            - the tree edge u -> v is done: every descendant of v is finished.
+//   finish_vertex(u)             - u is left (post-order).
+//
+//   0 -> 1 -> 2          discover 0, tree 0->1, discover 1, tree 1->2, discover 2, back 2->0,
+//   ^         |          finish 2, finish_edge 1->2, finish 1, finish_edge 0->1, finish 0
+//   +---------+
+//
+// DFS_Workspace holds the generation-stamped states and the stack. Keep one and pass it to every call: after the first
+// call no memory is allocated anymore, and a new search starts in O(1) instead of clearing O(V) marks.
+// On top of the engine: topological_sort(), has_cycle() and strongly_connected_components() (Tarjan).
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "csr_graph.h"
+#include "traversal_workspace.h"
+
+// Visitor with every event empty. Derive from it and hide the events you need.
+struct DFS_Visitor
+{
+    void discover_vertex(uint32_t) {}
+    void tree_edge(uint32_t, uint32_t) {}
+    void back_edge(uint32_t, uint32_t) {}
+    void forward_or_cross_edge(uint32_t, uint32_t) {}
+    void finish_edge(uint32_t, uint32_t) {}
+    void finish_vertex(uint32_t) {}
+};
+
+// Stamps of Traversal_Workspace give the three states of a vertex: not visited in this query, visited and still
+// on the stack, finished. Starting a new search is O(1).
+struct DFS_Workspace : Traversal_Workspace
+{
+    public:
+    struct Frame
+    {
+        uint32_t vertex;
+        uint32_t previous; // Scan state of the graph's next_neighbour(), fits into the padding.
+        uint64_t next_edge;
+    };
+
+    std::vector<Frame> stack;
+
+    void reset(uint32_t vertices)
+    {
+        begin(vertices);
+        stack.clear();
+    }
+};
+
+// Runs from source over vertices which are still unvisited in workspace. Does not reset the workspace,
+// hence several calls with different sources make up a DFS forest. Call workspace.reset() to start a new search.
+// parent(v) is the DFS tree, touched() lists vertices in pre-order. Graph is CSR_Graph or Compressed_Graph.
+template <typename Graph, typename Visitor>
+void depth_first_search(const Graph& graph, uint32_t source, Visitor& visitor, DFS_Workspace& workspace)
+{
+    if (workspace.is_visited(source)) { return; }
+
+    workspace.visit(source);
+    visitor.discover_vertex(source);
+    workspace.stack.push_back({source, 0, graph.first_edge(source)});
+
+    while (!workspace.stack.empty())
+    {
+        DFS_Workspace::Frame& frame = workspace.stack.back();
+        uint32_t u = frame.vertex;
+
+        if (frame.next_edge == graph.last_edge(u))
+        {
+            workspace.finish(u);
+            visitor.finish_vertex(u);
+            workspace.stack.pop_back();
+            if (!workspace.stack.empty()) { visitor.finish_edge(workspace.stack.back().vertex, u); }
+            continue;
+        }
+
+        uint32_t v = graph.next_neighbour(frame.next_edge, frame.previous);
+        if (!workspace.is_visited(v))
+        {
+            visitor.tree_edge(u, v);
+            workspace.visit(v);
+            workspace.set_parent(v, u);
+            visitor.discover_vertex(v);
+            workspace.stack.push_back({v, 0, graph.first_edge(v)}); // frame is invalid from here on.
+        }
+        else if (!workspace.is_finished(v))
+        {
+            visitor.back_edge(u, v);
+        }
+        else
+        {
+            visitor.forward_or_cross_edge(u, v);
+        }
+    }
+}
+
+// DFS forest over the whole graph: every unvisited vertex in id order becomes a root.
+template <typename Graph, typename Visitor>
+void depth_first_search(const Graph& graph, Visitor& visitor, DFS_Workspace& workspace)
+{
+    workspace.reset(graph.vertex_count());
+    for (uint32_t v = 0; v < graph.vertex_count(); v++)
+    {
+        depth_first_search(graph, v, visitor, workspace);
+    }
+}
+
+// Reverse post-order is a topological order of a DAG. Returns false (and an empty order) if the graph has a cycle.
+inline bool topological_sort(const CSR_Graph& graph, std::vector<uint32_t>& order, DFS_Workspace& workspace)
+{
+    struct Visitor : DFS_Visitor
+    {
+        std::vector<uint32_t>& order;
+        bool acyclic = true;
+        Visitor(std::vector<uint32_t>& order_) : order(order_) {}
+        void back_edge(uint32_t, uint32_t) { acyclic = false; }
+        void finish_vertex(uint32_t u) { order.push_back(u); }
+    };
+
+    order.clear();
+    order.reserve(graph.vertex_count());
+    Visitor visitor(order);
+    depth_first_search(graph, visitor, workspace);
+    if (!visitor.acyclic) { order.clear(); return false; }
+    std::reverse(order.begin(), order.end());
+    return true;
+}
+
+// Directed graphs only: in an undirected graph every edge back to the parent looks like a back edge.
+inline bool has_cycle(const CSR_Graph& graph, DFS_Workspace& workspace)
+{
+    struct Visitor : DFS_Visitor
+    {
+        bool cycle = false;
+        void back_edge(uint32_t, uint32_t) { cycle = true; }
+    };
+
+    Visitor visitor;
+    depth_first_search(graph, visitor, workspace);
+    return visitor.cycle;
+}
+
+// Tarjan's algorithm. low[u] - the smallest discovery index reachable from the subtree of u through at most one
+// non-tree edge into a vertex which is still on the Tarjan stack. u is the root of a component when low[u] == index[u].
+// Returns the number of components, component[v] is the id of the component of v (ids are in reverse topological order).
+inline uint32_t strongly_connected_components(const CSR_Graph& graph, std::vector<uint32_t>& component, DFS_Workspace& workspace)
+{
+    struct Visitor : DFS_Visitor
+    {
+        std::vector<uint32_t> index, low, tarjan_stack;
+        std::vector<uint32_t>& component;
+        uint32_t counter = 0, components = 0;
+
+        Visitor(uint32_t n, std::vector<uint32_t>& component_) : index(n), low(n), component(component_)
+        {
+            component.assign(n, UINT32_MAX); // Not assigned to a component yet.
+        }
+        void discover_vertex(uint32_t u)
+        {
+            index[u] = low[u] = counter++;
+            tarjan_stack.push_back(u);
+        }
+        void back_edge(uint32_t u, uint32_t v) { low[u] = std::min(low[u], index[v]); }
+        void forward_or_cross_edge(uint32_t u, uint32_t v)
+        {
+            if (component[v] == UINT32_MAX) { low[u] = std::min(low[u], index[v]); } // v is still on the Tarjan stack.
+        }
+        void finish_edge(uint32_t u, uint32_t v) { low[u] = std::min(low[u], low[v]); }
+        void finish_vertex(uint32_t u)
+        {
+            if (low[u] != index[u]) { return; }
+            uint32_t v;
+            do
+            {
+                v = tarjan_stack.back();
+                tarjan_stack.pop_back();
+                component[v] = components;
+            } while (v != u);
+            components++;
+        }
+    };
+
+    Visitor visitor(graph.vertex_count(), component);
+    depth_first_search(graph, visitor, workspace);
+    return visitor.components;
+}
+
+#endif // DFS_HPP
@@ -3,6 +3,16 @@
 #include <limits>
 #include <stack>
 #include "priority_queue.h"
+#include "pairing_heap.h"
+#include "csr_graph.h"
+#include "shortest_paths.h"
+
+// Build with -DUSE_PAIRING_HEAP to run the algorithm on Pairing_Heap instead of the binary Priority_Queue.
+#ifdef USE_PAIRING_HEAP
+template <typename T> using Min_Heap = Pairing_Heap<T>;
+#else
+template <typename T> using Min_Heap = Priority_Queue<T>;
+#endif
 
 constexpr int INF = std::numeric_limits<int>::max();
 
@@ -52,6 +62,7 @@ struct Graph {
     }
     void build_graph();
     void show_graph() const;
+    std::vector<CSR_Edge> edge_list() const;
 };
 
 void Graph::build_graph()
@@ -74,6 +85,19 @@ void Graph::show_graph() const
     }
 }
 
+std::vector<CSR_Edge> Graph::edge_list() const
+{
+    std::vector<CSR_Edge> edges;
+    for (const auto& vertex : adjacency_table)
+    {
+        for (const auto& edge : vertex.neighbour_info)
+        {
+            edges.emplace_back(CSR_Edge(edge.vertex_source, edge.vertex_destination, edge.weight));
+        }
+    }
+    return edges;
+}
+
 void dijkstra(Graph& graph, int start, int end)
 {
     std::vector<unsigned int> distances(graph.V,INF);
@@ -81,7 +105,7 @@ void dijkstra(Graph& graph, int start, int end)
 
     distances[start] = 0;
 
-    Priority_Queue<Vertex> min_heap;
+    Min_Heap<Vertex> min_heap;
 
     min_heap.insert(graph.adjacency_table[start]);
 
@@ -127,6 +151,28 @@ void dijkstra(Graph& graph, int start, int end)
     std::cout << std::endl;
 }
 
+// The same algorithm on the shared CSR representation. The search itself lives in shortest_paths.h and keeps its state
+// in a reusable workspace, here we only print it.
+void dijkstra(const CSR_Graph& graph, int start, int end, Traversal_Workspace& workspace)
+{
+    dijkstra<Min_Heap<Heap_Entry>>(graph, start, workspace);
+
+    std::cout << "Distances from vertex " << start << ":\n";
+    for (uint32_t i = 0; i < graph.vertex_count(); i++)
+    {
+        unsigned int distance = workspace.distance(i);
+        std::cout << "To vertex " << i << ": " << ((distance == Traversal_Workspace::INF) ? "INF" : std::to_string(distance)) << std::endl;
+    }
+
+    std::vector<uint32_t> path = extract_path(workspace, end);
+    for (size_t i = 0; i < path.size(); i++)
+    {
+        std::cout << path[i];
+        if (i + 1 < path.size()) std::cout << " -> ";
+    }
+    std::cout << std::endl;
+}
+
 int main()
 {
     Graph g(5);
@@ -134,5 +180,21 @@ int main()
     g.show_graph();
     std::cout << "\nRunning Dijkstra's algorithm...\n";
     dijkstra(g,0,4);
+    std::cout << "\nRunning Dijkstra's algorithm on CSR graph...\n";
+    CSR_Graph csr = CSR_Graph::from_edges(g.V, g.edge_list());
+    Traversal_Workspace workspace;
+    dijkstra(csr,0,4,workspace);
+
+    std::cout << "\nRunning bidirectional Dijkstra from 0 to 4...\n";
+    Traversal_Workspace backward;
+    Bidirectional_Result result = bidirectional_dijkstra<Min_Heap<Heap_Entry>>(csr, csr.reversed(), 0, 4, workspace, backward);
+    std::cout << "Distance: " << result.distance << "\tSettled vertices: " << result.settled << std::endl;
+    std::vector<uint32_t> path = extract_path(workspace, backward, result);
+    for (size_t i = 0; i < path.size(); i++)
+    {
+        std::cout << path[i];
+        if (i + 1 < path.size()) std::cout << " -> ";
+    }
+    std::cout << std::endl;
     return 0;
 }
\ No newline at end of file
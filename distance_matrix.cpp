@@ -0,0 +1,84 @@
+// N x M distance tables on a road-like grid (right and lower neighbour, weights 1..1000): one Dijkstra per source on
+// a thread pool against bucket-based many-to-many on a Contraction_Hierarchy. Both tables are compared, the float16
+// table is checked for its relative error, and a streamed file is read back and compared.
+// Usage: ./distance_matrix [width] [height] [sources] [targets]
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <memory>
+#include "csr_graph.h"
+#include "contraction_hierarchies.h"
+#include "distance_matrix.h"
+#include "graph_generators.h"
+#include "thread_pool.h"
+#include "timing.h"
+
+int main(int argc, char* argv[])
+{
+    uint32_t width = argc > 1 ? std::atoi(argv[1]) : 150;
+    uint32_t height = argc > 2 ? std::atoi(argv[2]) : 150;
+    uint32_t source_count = argc > 3 ? std::atoi(argv[3]) : 200;
+    uint32_t target_count = argc > 4 ? std::atoi(argv[4]) : 200;
+    uint32_t vertices = width * height;
+
+    Thread_Pool pool;
+    std::mt19937 rng(42);
+    CSR_Graph graph = generate_graph(Grid_Generator(width, height, 42), pool, true);
+    std::vector<uint32_t> sources(source_count), targets(target_count);
+    for (auto& source : sources) { source = rng() % vertices; }
+    for (auto& target : targets) { target = rng() % vertices; }
+    std::cout << "Vertices: " << vertices << "\tTable: " << source_count << " x " << target_count << std::endl;
+
+    Distance_Matrix<uint32_t> expected;
+    double seconds = measure([&]() {
+        Dijkstra_Many_To_Many engine(graph, sources, targets, pool);
+        expected = distance_matrix(engine);
+    });
+    std::cout << "Dijkstra per source:\t" << seconds << " s\tthreads: " << pool.size() << std::endl;
+
+    std::unique_ptr<Contraction_Hierarchy> hierarchy;
+    seconds = measure([&]() { hierarchy.reset(new Contraction_Hierarchy(graph, pool)); });
+    std::cout << "CH preprocessing:\t" << seconds << " s" << std::endl;
+
+    Distance_Matrix<uint32_t> table;
+    std::unique_ptr<CH_Many_To_Many> buckets;
+    seconds = measure([&]() { buckets.reset(new CH_Many_To_Many(*hierarchy, sources, targets, pool)); });
+    std::cout << "CH buckets:\t\t" << seconds << " s\tentries: " << buckets->bucket_entry_count() << std::endl;
+    seconds = measure([&]() { table = distance_matrix(*buckets); });
+    bool correct = true;
+    for (uint32_t i = 0; i < source_count; i++)
+    {
+        for (uint32_t j = 0; j < target_count; j++) { correct &= table.row(i)[j] == expected.row(i)[j]; }
+    }
+    std::cout << "CH table:\t\t" << seconds << " s\t" << table.memory_bytes() << " bytes" << (correct ? "" : "\tMISMATCH") << std::endl;
+
+    Distance_Matrix<Half> compact = distance_matrix<Half>(*buckets, 10.0);
+    double worst = 0;
+    for (uint32_t i = 0; i < source_count; i++)
+    {
+        for (uint32_t j = 0; j < target_count; j++)
+        {
+            if (std::isinf(expected.at(i, j))) { correct &= std::isinf(compact.at(i, j)); continue; }
+            if (expected.at(i, j) > 0) { worst = std::max(worst, std::fabs(compact.at(i, j) - expected.at(i, j)) / expected.at(i, j)); }
+        }
+    }
+    std::cout << "Float16 table, unit 10:\t" << compact.memory_bytes() << " bytes\tworst relative error: " << worst
+              << (worst < 1.0 / 2048 && correct ? "" : "\tMISMATCH") << std::endl;
+
+    const char* filename = "distances.dmx";
+    seconds = measure([&]() { stream_distance_matrix(*buckets, filename, 1.0, 64); });
+    Distance_Matrix<uint32_t> loaded = Distance_Matrix<uint32_t>::load(filename);
+    correct = loaded.row_count() == source_count && loaded.column_count() == target_count;
+    for (uint32_t i = 0; correct && i < source_count; i++)
+    {
+        for (uint32_t j = 0; j < target_count; j++) { correct &= loaded.row(i)[j] == expected.row(i)[j]; }
+    }
+    std::cout << "Streamed to " << filename << ":\t" << seconds << " s" << (correct ? "" : "\tMISMATCH") << std::endl;
+    std::remove(filename);
+
+    return 0;
+}
@@ -0,0 +1,310 @@
+#ifndef DISTANCE_MATRIX_HPP
+#define DISTANCE_MATRIX_HPP
+
+// Many-to-many shortest path distances: for sources s_0 .. s_N-1 and targets t_0 .. t_M-1 the N x M table d(s_i, t_j),
+// dense and row-major (row i = all targets of source i).
+//
+// Two engines fill rows, both with row_count(), column_count() and compute_rows(first, count, out):
+//   Dijkstra_Many_To_Many - one Dijkstra per source on a Thread_Pool, each stops when every target is settled.
+//   CH_Many_To_Many       - bucket-based (Knopp et al.) on a Contraction_Hierarchy. Once, a backward upward search from
+//                           every target t_j leaves an entry (j, d(v, t_j)) in the bucket of every vertex v it reaches.
+//                           Then the forward upward search from s_i only scans buckets of the vertices it reaches:
+//
+//                               d(s_i, t_j) = min over v of  d(s_i, v) [forward]  +  d(v, t_j) [bucket of v]
+//
+//                           Each search sees a few hundred vertices, instead of a big part of the graph.
+//
+// Values are stored as uint32_t (exact, Distance_Matrix::INF if unreachable) or as Half, an IEEE 754 binary16 number
+// (half the memory, relative error below 2^-11). Half holds at most 65504, so the distance is stored in units of
+// `unit`: unit = 100 keeps distances up to 6.5 million. Bigger values saturate, unreachable ones are infinity.
+// stream_distance_matrix() computes blocks of rows and appends them to a file, only one block is ever in memory.
+// File: magic, rows, columns, bytes per value, unit, then the values row after row. Distance_Matrix::load() reads it back.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "csr_graph.h"
+#include "contraction_hierarchies.h"
+#include "shortest_paths.h"
+#include "thread_pool.h"
+#include "traversal_workspace.h"
+
+struct Half {
+    public:
+    uint16_t bits;
+
+    static constexpr uint16_t infinity = 0x7c00;
+    static constexpr uint16_t max_finite = 0x7bff;
+
+    // Non-negative values only. Rounds to nearest, saturates at 65504.
+    static Half from_float(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        int exponent = int((bits >> 23) & 0xff) - 127 + 15;
+        uint32_t mantissa = bits & 0x7fffff;
+        if (value == 0) { return Half{0}; }
+        if (exponent >= 31) { return Half{max_finite}; }
+        if (exponent <= 0) // Subnormal: 2^-24 steps.
+        {
+            if (exponent < -10) { return Half{0}; }
+            mantissa |= 0x800000;
+            int shift = 14 - exponent;
+            uint32_t half = mantissa >> shift;
+            if ((mantissa >> (shift - 1)) & 1) { half++; }
+            return Half{uint16_t(half)};
+        }
+        uint32_t half = (uint32_t(exponent) << 10) | (mantissa >> 13);
+        uint32_t rest = mantissa & 0x1fff;
+        if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) { half++; } // A carry moves into the exponent correctly.
+        return Half{uint16_t(std::min<uint32_t>(half, max_finite))};
+    }
+
+    float to_float() const
+    {
+        uint32_t exponent = (bits >> 10) & 0x1f;
+        uint32_t mantissa = bits & 0x3ff;
+        if (exponent == 0x1f) { return std::numeric_limits<float>::infinity(); }
+        if (exponent == 0) { return std::ldexp(float(mantissa), -24); }
+        return std::ldexp(float(1024 + mantissa), int(exponent) - 25);
+    }
+};
+
+template <typename T = uint32_t>
+class Distance_Matrix
+{
+    public:
+    static constexpr unsigned int INF = Traversal_Workspace::INF;
+
+    private:
+    uint32_t rows;
+    uint32_t columns;
+    double unit;
+    std::vector<T> values;
+
+    static constexpr uint32_t file_magic = 0x31584d44; // "DMX1"
+
+    public:
+    Distance_Matrix(uint32_t rows_ = 0, uint32_t columns_ = 0, double unit_ = 1.0)
+        : rows(rows_), columns(columns_), unit(unit_), values(uint64_t(rows_) * columns_) {}
+
+    static T encode(unsigned int distance, double unit);
+    static double decode(T value, double unit);
+
+    uint32_t row_count() const { return rows; }
+    uint32_t column_count() const { return columns; }
+    double get_unit() const { return unit; }
+    T* row(uint32_t i) { return values.data() + uint64_t(i) * columns; }
+    const T* row(uint32_t i) const { return values.data() + uint64_t(i) * columns; }
+    const T* data() const { return values.data(); }
+
+    // Distance from source i to target j, infinity if unreachable.
+    double at(uint32_t i, uint32_t j) const { return decode(row(i)[j], unit); }
+
+    void store_rows(uint32_t first, uint32_t count, const unsigned int* distances)
+    {
+        for (uint64_t k = 0; k < uint64_t(count) * columns; k++) { values[uint64_t(first) * columns + k] = encode(distances[k], unit); }
+    }
+
+    uint64_t memory_bytes() const { return values.size() * sizeof(T); }
+
+    static void write_header(std::ofstream& file, uint32_t rows, uint32_t columns, double unit)
+    {
+        uint32_t header[4] = {file_magic, rows, columns, uint32_t(sizeof(T))};
+        file.write(reinterpret_cast<const char*>(header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(&unit), sizeof(unit));
+    }
+
+    void save(const std::string& filename) const
+    {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file) { throw std::runtime_error("Cannot open " + filename); }
+        write_header(file, rows, columns, unit);
+        file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+        if (!file) { throw std::runtime_error("Cannot write " + filename); }
+    }
+
+    static Distance_Matrix load(const std::string& filename)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file) { throw std::runtime_error("Cannot open " + filename); }
+        uint32_t header[4];
+        double unit;
+        file.read(reinterpret_cast<char*>(header), sizeof(header));
+        file.read(reinterpret_cast<char*>(&unit), sizeof(unit));
+        if (!file || header[0] != file_magic || header[3] != sizeof(T)) { throw std::runtime_error(filename + " is not a matching distance matrix"); }
+
+        Distance_Matrix matrix(header[1], header[2], unit);
+        file.read(reinterpret_cast<char*>(matrix.values.data()), matrix.values.size() * sizeof(T));
+        if (!file) { throw std::runtime_error(filename + " is truncated"); }
+        return matrix;
+    }
+};
+
+template <>
+inline uint32_t Distance_Matrix<uint32_t>::encode(unsigned int distance, double) { return distance; }
+template <>
+inline double Distance_Matrix<uint32_t>::decode(uint32_t value, double)
+{
+    return value == INF ? std::numeric_limits<double>::infinity() : double(value);
+}
+template <>
+inline Half Distance_Matrix<Half>::encode(unsigned int distance, double unit)
+{
+    return distance == INF ? Half{Half::infinity} : Half::from_float(float(distance / unit));
+}
+template <>
+inline double Distance_Matrix<Half>::decode(Half value, double unit) { return double(value.to_float()) * unit; }
+
+class Dijkstra_Many_To_Many
+{
+    private:
+    const CSR_Graph& graph;
+    Thread_Pool& pool;
+    std::vector<uint32_t> sources;
+    std::vector<uint32_t> targets;
+    std::vector<char> is_target;
+    uint32_t distinct_targets = 0;
+    std::vector<Traversal_Workspace> workspaces;
+
+    public:
+    Dijkstra_Many_To_Many(const CSR_Graph& graph_, const std::vector<uint32_t>& sources_, const std::vector<uint32_t>& targets_, Thread_Pool& pool_)
+        : graph(graph_), pool(pool_), sources(sources_), targets(targets_), is_target(graph_.vertex_count(), 0), workspaces(pool_.size())
+    {
+        for (uint32_t t : targets)
+        {
+            if (!is_target[t]) { is_target[t] = 1; distinct_targets++; }
+        }
+    }
+
+    uint32_t row_count() const { return uint32_t(sources.size()); }
+    uint32_t column_count() const { return uint32_t(targets.size()); }
+
+    // out: count x column_count() distances, row-major.
+    void compute_rows(uint32_t first, uint32_t count, unsigned int* out)
+    {
+        pool.parallel_for(0, count, [&](uint64_t i, int thread_index) {
+            Traversal_Workspace& workspace = workspaces[thread_index];
+            uint32_t left = distinct_targets;
+            dijkstra_until(graph, sources[first + i], workspace, [&](uint32_t u) { return is_target[u] && --left == 0; });
+            unsigned int* row = out + i * targets.size();
+            for (size_t j = 0; j < targets.size(); j++) { row[j] = workspace.distance(targets[j]); }
+        }, 1);
+    }
+};
+
+class CH_Many_To_Many
+{
+    private:
+    struct Bucket_Entry
+    {
+        uint32_t column;
+        unsigned int distance;
+    };
+
+    const Contraction_Hierarchy& hierarchy;
+    Thread_Pool& pool;
+    std::vector<uint32_t> sources;
+    uint32_t columns;
+    std::vector<uint64_t> bucket_offsets; // Bucket of v: bucket_entries[bucket_offsets[v] .. bucket_offsets[v + 1])
+    std::vector<Bucket_Entry> bucket_entries;
+    std::vector<Traversal_Workspace> workspaces;
+
+    public:
+    CH_Many_To_Many(const Contraction_Hierarchy& hierarchy_, const std::vector<uint32_t>& sources_, const std::vector<uint32_t>& targets,
+                    Thread_Pool& pool_)
+        : hierarchy(hierarchy_), pool(pool_), sources(sources_), columns(uint32_t(targets.size())),
+          bucket_offsets(hierarchy_.vertex_count() + 1, 0), workspaces(pool_.size())
+    {
+        struct Found
+        {
+            uint32_t vertex;
+            Bucket_Entry entry;
+        };
+        std::vector<std::vector<Found>> found(pool.size());
+        pool.parallel_for(0, targets.size(), [&](uint64_t j, int thread_index) {
+            Traversal_Workspace& workspace = workspaces[thread_index];
+            dijkstra(hierarchy.downward_graph(), targets[j], workspace);
+            for (uint32_t v : workspace.touched()) { found[thread_index].push_back(Found{v, Bucket_Entry{uint32_t(j), workspace.distance(v)}}); }
+        }, 1);
+
+        for (const auto& local : found)
+        {
+            for (const Found& f : local) { bucket_offsets[f.vertex + 1]++; }
+        }
+        for (uint32_t v = 0; v < hierarchy.vertex_count(); v++) { bucket_offsets[v + 1] += bucket_offsets[v]; }
+        bucket_entries.resize(bucket_offsets.back());
+        std::vector<uint64_t> position(bucket_offsets.begin(), bucket_offsets.end() - 1);
+        for (const auto& local : found)
+        {
+            for (const Found& f : local) { bucket_entries[position[f.vertex]++] = f.entry; }
+        }
+    }
+
+    uint32_t row_count() const { return uint32_t(sources.size()); }
+    uint32_t column_count() const { return columns; }
+    uint64_t bucket_entry_count() const { return bucket_entries.size(); }
+
+    void compute_rows(uint32_t first, uint32_t count, unsigned int* out)
+    {
+        pool.parallel_for(0, count, [&](uint64_t i, int thread_index) {
+            Traversal_Workspace& workspace = workspaces[thread_index];
+            unsigned int* row = out + i * columns;
+            std::fill(row, row + columns, Traversal_Workspace::INF);
+            dijkstra(hierarchy.upward_graph(), sources[first + i], workspace);
+            for (uint32_t v : workspace.touched())
+            {
+                unsigned int distance = workspace.distance(v);
+                for (uint64_t k = bucket_offsets[v]; k < bucket_offsets[v + 1]; k++)
+                {
+                    const Bucket_Entry& entry = bucket_entries[k];
+                    row[entry.column] = std::min(row[entry.column], distance + entry.distance);
+                }
+            }
+        }, 1);
+    }
+};
+
+// Whole matrix in memory. Rows are computed block_rows at a time, so the unsigned scratch stays small for Half.
+template <typename T = uint32_t, typename Engine>
+Distance_Matrix<T> distance_matrix(Engine& engine, double unit = 1.0, uint32_t block_rows = 256)
+{
+    Distance_Matrix<T> matrix(engine.row_count(), engine.column_count(), unit);
+    std::vector<unsigned int> block(uint64_t(block_rows) * engine.column_count());
+    for (uint32_t first = 0; first < engine.row_count(); first += block_rows)
+    {
+        uint32_t count = std::min(block_rows, engine.row_count() - first);
+        engine.compute_rows(first, count, block.data());
+        matrix.store_rows(first, count, block.data());
+    }
+    return matrix;
+}
+
+// Same layout as Distance_Matrix::save(), for matrices which do not fit in memory.
+template <typename T = uint32_t, typename Engine>
+void stream_distance_matrix(Engine& engine, const std::string& filename, double unit = 1.0, uint32_t block_rows = 256)
+{
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) { throw std::runtime_error("Cannot open " + filename); }
+    Distance_Matrix<T>::write_header(file, engine.row_count(), engine.column_count(), unit);
+
+    std::vector<unsigned int> block(uint64_t(block_rows) * engine.column_count());
+    std::vector<T> encoded(block.size());
+    for (uint32_t first = 0; first < engine.row_count(); first += block_rows)
+    {
+        uint32_t count = std::min(block_rows, engine.row_count() - first);
+        engine.compute_rows(first, count, block.data());
+        uint64_t size = uint64_t(count) * engine.column_count();
+        for (uint64_t k = 0; k < size; k++) { encoded[k] = Distance_Matrix<T>::encode(block[k], unit); }
+        file.write(reinterpret_cast<const char*>(encoded.data()), size * sizeof(T));
+        if (!file) { throw std::runtime_error("Cannot write " + filename); }
+    }
+}
+
+#endif // DISTANCE_MATRIX_HPP
@@ -0,0 +1,431 @@
+#ifndef DYNAMIC_MST_HPP
+#define DYNAMIC_MST_HPP
+
+// Minimum spanning forest under edge updates, without recomputing it from all E edges every time.
+//
+// The forest lives in a link-cut tree (Sleator & Tarjan): every vertex and every tree edge is a node, an edge node sits
+// between its two vertices, and every splay tree keeps the heaviest edge of its path. Link, cut and path maximum are
+// O(log n) amortized.
+//
+//   insert_edge(u, v, w)   - u, v in different trees: link them through the new edge. Otherwise the tree path u ... v plus
+//                            the new edge is a cycle; if its heaviest edge is heavier than w, it is cut out and the new edge
+//                            linked in (cycle property), else the new edge stays outside the forest.
+//
+//        u ---3--- a ---9--- v          insert (u, v, 5):  path max is 9 -> cut (a, v), link (u, v)
+//
+//   decrease_weight(e, w)  - a tree edge only gets better and stays; a non-tree edge is treated like a new insertion.
+//   remove_edge(e)         - a non-tree edge just disappears. A tree edge is cut, and the replacement is searched right
+//                            away: the lightest live edge between the two halves. Both halves are grown at the same
+//                            pace over forest edges; the one which runs out first is the smaller side S, and the answer
+//                            is the lightest edge incident to S whose other end is outside S.
+//
+//            S             rest of the tree        cut (b, c): S = {a, b} runs out in the second round, so only the
+//         a - b   --x--   c - d - e - f ...        edges incident to a and b are read, however big the rest is
+//
+//                            The search gives up after search_budget edge incidences (about sqrt E): an even split would
+//                            cost O(E). The removal is then pending, and so are all tree-edge removals after it until
+//                            rebuild() recomputes the forest by Kruskal over the live edges (kept in a std::set ordered by
+//                            (weight, id), so nothing is sorted: O(E α + V log V)). That happens when about E / budget
+//                            removals are pending, or at the next query.
+//
+// Costs: insertions and decreases O(log n) amortized; a removal O(log n + budget) plus its share of a rebuild, which is
+// O(sqrt E) amortized while queries are rarer than full batches. A query right after a pending removal pays the whole
+// rebuild, so alternating hard removals and queries cost O(E) each. Polylog removals in the worst case need the far
+// heavier structure of Holm, de Lichtenberg and Thorup, which this class does not attempt.
+// Equal weights are ordered by edge id, so the forest is unique and always the one Kruskal on (weight, id) would pick.
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "csr_graph.h"
+#include "spanning_tree.h"
+
+class Dynamic_MST
+{
+    private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct Edge_Record
+    {
+        uint32_t from, to;
+        int32_t weight;
+        uint32_t slot[2]; // Positions in incident[from] and incident[to].
+        bool alive, in_forest;
+    };
+
+    // Link-cut tree. Nodes 0..V-1 are vertices, node V + e is edge e. max_node is the node of the heaviest edge in the
+    // splay subtree (NONE if it has no edge node).
+    struct Node
+    {
+        uint32_t child[2] = {NONE, NONE};
+        uint32_t parent = NONE;
+        uint32_t max_node = NONE;
+        bool reversed = false;
+    };
+
+    uint32_t vertices;
+    std::vector<Edge_Record> edge_records;
+    std::vector<std::vector<uint32_t>> incident; // Live edges of every vertex, self-loops left out.
+    std::vector<Node> nodes;
+    std::set<std::pair<int32_t, uint32_t>> live; // (weight, id) of every live edge.
+    uint64_t search_budget;
+    uint64_t pending_removals = 0; // Tree edges removed without a replacement search since the last rebuild.
+    uint64_t rebuilds = 0;
+    int64_t forest_weight = 0;
+    uint32_t forest_size = 0;
+    std::vector<uint32_t> splay_path; // Scratch of splay().
+    std::vector<uint32_t> side_mark;  // Stamps of the two halves in reconnect().
+    uint32_t side_epoch = 0;
+    std::vector<uint32_t> side_queue[2];
+
+    bool heavier(uint32_t a, uint32_t b) const // Nodes of edges, NONE is lighter than anything.
+    {
+        if (b == NONE) { return a != NONE; }
+        if (a == NONE) { return false; }
+        const Edge_Record& x = edge_records[a - vertices];
+        const Edge_Record& y = edge_records[b - vertices];
+        return x.weight > y.weight || (x.weight == y.weight && a > b);
+    }
+
+    bool is_splay_root(uint32_t x) const
+    {
+        uint32_t p = nodes[x].parent;
+        return p == NONE || (nodes[p].child[0] != x && nodes[p].child[1] != x);
+    }
+
+    void update(uint32_t x)
+    {
+        uint32_t best = x >= vertices ? x : NONE;
+        for (uint32_t c : nodes[x].child)
+        {
+            if (c != NONE && heavier(nodes[c].max_node, best)) { best = nodes[c].max_node; }
+        }
+        nodes[x].max_node = best;
+    }
+
+    void push_down(uint32_t x)
+    {
+        if (!nodes[x].reversed) { return; }
+        std::swap(nodes[x].child[0], nodes[x].child[1]);
+        for (uint32_t c : nodes[x].child) { if (c != NONE) { nodes[c].reversed = !nodes[c].reversed; } }
+        nodes[x].reversed = false;
+    }
+
+    void rotate(uint32_t x)
+    {
+        uint32_t p = nodes[x].parent, g = nodes[p].parent;
+        int side = nodes[p].child[1] == x;
+        if (!is_splay_root(p)) { nodes[g].child[nodes[g].child[1] == p] = x; }
+        nodes[x].parent = g;
+        nodes[p].child[side] = nodes[x].child[!side];
+        if (nodes[x].child[!side] != NONE) { nodes[nodes[x].child[!side]].parent = p; }
+        nodes[x].child[!side] = p;
+        nodes[p].parent = x;
+        update(p);
+        update(x);
+    }
+
+    void splay(uint32_t x)
+    {
+        // Reversal flags are pushed from the top of the splay tree down to x before any rotation.
+        std::vector<uint32_t>& path = splay_path;
+        path.clear();
+        for (uint32_t y = x; ; y = nodes[y].parent)
+        {
+            path.push_back(y);
+            if (is_splay_root(y)) { break; }
+        }
+        for (size_t i = path.size(); i-- > 0;) { push_down(path[i]); }
+        while (!is_splay_root(x))
+        {
+            uint32_t p = nodes[x].parent;
+            if (!is_splay_root(p))
+            {
+                uint32_t g = nodes[p].parent;
+                rotate((nodes[g].child[1] == p) == (nodes[p].child[1] == x) ? p : x);
+            }
+            rotate(x);
+        }
+    }
+
+    void access(uint32_t x)
+    {
+        uint32_t last = NONE;
+        for (uint32_t y = x; y != NONE; y = nodes[y].parent)
+        {
+            splay(y);
+            nodes[y].child[1] = last;
+            update(y);
+            last = y;
+        }
+        splay(x);
+    }
+
+    void make_root(uint32_t x)
+    {
+        access(x);
+        nodes[x].reversed = !nodes[x].reversed;
+    }
+
+    uint32_t find_root(uint32_t x)
+    {
+        access(x);
+        while (true)
+        {
+            push_down(x);
+            if (nodes[x].child[0] == NONE) { break; }
+            x = nodes[x].child[0];
+        }
+        splay(x);
+        return x;
+    }
+
+    void link(uint32_t x, uint32_t y)
+    {
+        make_root(x);
+        nodes[x].parent = y;
+    }
+
+    void cut(uint32_t x, uint32_t y) // x and y are adjacent in the represented tree.
+    {
+        make_root(x);
+        access(y);
+        nodes[y].child[0] = NONE;
+        nodes[x].parent = NONE;
+        update(y);
+    }
+
+    // Heaviest edge node on the tree path u ... v (both in one tree).
+    uint32_t path_max(uint32_t u, uint32_t v)
+    {
+        make_root(u);
+        access(v);
+        return nodes[v].max_node;
+    }
+
+    void add_to_forest(uint32_t id)
+    {
+        Edge_Record& edge = edge_records[id];
+        link(edge.from, vertices + id);
+        link(vertices + id, edge.to);
+        edge.in_forest = true;
+        forest_weight += edge.weight;
+        forest_size++;
+    }
+
+    void remove_from_forest(uint32_t id)
+    {
+        Edge_Record& edge = edge_records[id];
+        cut(edge.from, vertices + id);
+        cut(vertices + id, edge.to);
+        edge.in_forest = false;
+        forest_weight -= edge.weight;
+        forest_size--;
+    }
+
+    // The edge is live and not in the forest: put it in if it improves the forest.
+    void offer(uint32_t id)
+    {
+        const Edge_Record& edge = edge_records[id];
+        if (edge.from == edge.to) { return; }
+        if (find_root(edge.from) != find_root(edge.to)) { add_to_forest(id); return; }
+        uint32_t heaviest = path_max(edge.from, edge.to);
+        if (heavier(heaviest, vertices + id))
+        {
+            remove_from_forest(heaviest - vertices);
+            add_to_forest(id);
+        }
+    }
+
+    Edge_Record& live_record(uint32_t id)
+    {
+        if (id >= edge_records.size() || !edge_records[id].alive) { throw std::out_of_range("Dynamic_MST: no such edge"); }
+        return edge_records[id];
+    }
+
+    void attach(uint32_t id)
+    {
+        Edge_Record& edge = edge_records[id];
+        if (edge.from == edge.to) { return; }
+        edge.slot[0] = uint32_t(incident[edge.from].size());
+        incident[edge.from].push_back(id);
+        edge.slot[1] = uint32_t(incident[edge.to].size());
+        incident[edge.to].push_back(id);
+    }
+
+    void detach(uint32_t id)
+    {
+        const Edge_Record& edge = edge_records[id];
+        if (edge.from == edge.to) { return; }
+        for (int end = 0; end < 2; end++)
+        {
+            uint32_t v = end == 0 ? edge.from : edge.to;
+            std::vector<uint32_t>& list = incident[v];
+            uint32_t moved = list.back();
+            list[edge.slot[end]] = moved;
+            Edge_Record& other = edge_records[moved];
+            other.slot[other.from == v ? 0 : 1] = edge.slot[end];
+            list.pop_back();
+        }
+    }
+
+    uint64_t budget() const
+    {
+        if (search_budget > 0) { return search_budget; }
+        uint64_t root = 1;
+        while (root * root < live.size()) { root++; }
+        return std::max<uint64_t>(64, 2 * root);
+    }
+
+    // The forest edge between a and b was cut: link the lightest live edge between the two halves, if there is one.
+    // False if the search read more than budget() incidences before one half was complete; nothing is linked then.
+    bool reconnect(uint32_t a, uint32_t b)
+    {
+        uint64_t scanned = 0, limit = budget();
+        if (side_epoch >= UINT32_MAX - 2) { std::fill(side_mark.begin(), side_mark.end(), 0); side_epoch = 0; }
+        side_epoch += 2;
+        const uint32_t stamp[2] = {side_epoch, side_epoch + 1};
+        uint32_t start[2] = {a, b};
+        size_t head[2] = {0, 0};
+        for (int side = 0; side < 2; side++)
+        {
+            side_queue[side].assign(1, start[side]);
+            side_mark[start[side]] = stamp[side];
+        }
+        // One vertex of each side per round; the first side without a next vertex is complete.
+        int small = -1;
+        while (small < 0)
+        {
+            for (int side = 0; side < 2 && small < 0; side++)
+            {
+                if (head[side] == side_queue[side].size()) { small = side; break; }
+                uint32_t u = side_queue[side][head[side]++];
+                scanned += incident[u].size();
+                if (scanned > limit) { return false; }
+                for (uint32_t id : incident[u])
+                {
+                    const Edge_Record& edge = edge_records[id];
+                    uint32_t v = edge.from == u ? edge.to : edge.from;
+                    if (edge.in_forest && side_mark[v] != stamp[side])
+                    {
+                        side_mark[v] = stamp[side];
+                        side_queue[side].push_back(v);
+                    }
+                }
+            }
+        }
+        uint32_t best = NONE;
+        for (uint32_t u : side_queue[small])
+        {
+            for (uint32_t id : incident[u])
+            {
+                const Edge_Record& edge = edge_records[id];
+                uint32_t v = edge.from == u ? edge.to : edge.from;
+                if (side_mark[v] != stamp[small] && (best == NONE || heavier(best, vertices + id))) { best = vertices + id; }
+            }
+        }
+        if (best != NONE) { add_to_forest(best - vertices); }
+        return true;
+    }
+
+    void rebuild_if_pending()
+    {
+        if (pending_removals > 0) { rebuild(); }
+    }
+
+    public:
+    // search_budget - edge incidences a replacement search may read before the removal is left to a rebuild;
+    // 0 = automatic (about 2 sqrt of the live edge count, at least 64).
+    explicit Dynamic_MST(uint32_t vertices_, uint64_t search_budget_ = 0)
+        : vertices(vertices_), search_budget(search_budget_), incident(vertices_), nodes(vertices_), side_mark(vertices_, 0) {}
+
+    uint32_t insert_edge(uint32_t from, uint32_t to, int32_t weight)
+    {
+        if (from >= vertices || to >= vertices) { throw std::out_of_range("Dynamic_MST: vertex out of range"); }
+        uint32_t id = uint32_t(edge_records.size());
+        edge_records.push_back({from, to, weight, {0, 0}, true, false});
+        attach(id);
+        nodes.emplace_back();
+        nodes.back().max_node = vertices + id;
+        live.insert({weight, id});
+        offer(id);
+        return id;
+    }
+
+    void decrease_weight(uint32_t id, int32_t weight)
+    {
+        Edge_Record& edge = live_record(id);
+        if (weight > edge.weight) { throw std::invalid_argument("Dynamic_MST: decrease_weight with a greater weight"); }
+        live.erase({edge.weight, id});
+        live.insert({weight, id});
+        if (edge.in_forest)
+        {
+            // Lighter tree edge: the forest stays minimal, only the maxima on its splay path change.
+            access(vertices + id);
+            forest_weight += int64_t(weight) - edge.weight;
+            edge.weight = weight;
+            update(vertices + id);
+            return;
+        }
+        edge.weight = weight;
+        offer(id);
+    }
+
+    void remove_edge(uint32_t id)
+    {
+        Edge_Record& edge = live_record(id);
+        live.erase({edge.weight, id});
+        detach(id);
+        edge.alive = false;
+        if (!edge.in_forest) { return; }
+        remove_from_forest(id);
+        // Once a removal is pending the forest may lack edges, a search on it would prove nothing: leave it to the rebuild.
+        if (pending_removals == 0 && reconnect(edge.from, edge.to)) { return; }
+        pending_removals++;
+        if (pending_removals >= std::max<uint64_t>(1, live.size() / budget())) { rebuild(); }
+    }
+
+    // Kruskal over the live edges in (weight, id) order; the link-cut tree is rebuilt from the result.
+    void rebuild()
+    {
+        for (uint32_t x = 0; x < nodes.size(); x++) { nodes[x] = Node(); if (x >= vertices) { nodes[x].max_node = x; } }
+        for (Edge_Record& edge : edge_records) { edge.in_forest = false; }
+        forest_weight = 0;
+        forest_size = 0;
+        Union_Find sets(vertices);
+        for (const auto& entry : live)
+        {
+            if (forest_size + 1 >= vertices) { break; }
+            const Edge_Record& edge = edge_records[entry.second];
+            if (sets.unite(edge.from, edge.to)) { add_to_forest(entry.second); }
+        }
+        pending_removals = 0;
+        rebuilds++;
+    }
+
+    // Queries resolve pending removals first.
+    int64_t total_weight() { rebuild_if_pending(); return forest_weight; }
+    uint32_t forest_edge_count() { rebuild_if_pending(); return forest_size; }
+    bool is_forest_edge(uint32_t id) { rebuild_if_pending(); return live_record(id).in_forest; }
+
+    Spanning_Forest forest()
+    {
+        rebuild_if_pending();
+        Spanning_Forest result;
+        for (const Edge_Record& edge : edge_records)
+        {
+            if (edge.in_forest) { result.edges.emplace_back(edge.from, edge.to, edge.weight); }
+        }
+        result.total_weight = forest_weight;
+        return result;
+    }
+
+    uint32_t vertex_count() const { return vertices; }
+    uint64_t live_edge_count() const { return live.size(); }
+    uint64_t rebuild_count() const { return rebuilds; }
+};
+
+#endif // DYNAMIC_MST_HPP
@@ -0,0 +1,92 @@
+// Dynamic_MST of dynamic_mst.h against rerunning Kruskal after every change. A random network gets a stream of updates:
+// new links, cheaper links, and removed links (a given share of them). Every `check_every` updates the maintained forest
+// is compared with Kruskal (sort + scan) over the current edges; total weight and forest size must match.
+// Usage: ./dynamic_mst_benchmark [vertices] [edges] [updates] [remove_percent]
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include "csr_graph.h"
+#include "dynamic_mst.h"
+#include "graph_generators.h"
+#include "spanning_tree.h"
+#include "thread_pool.h"
+#include "timing.h"
+
+int main(int argc, char* argv[])
+{
+    uint32_t vertices = argc > 1 ? std::atoi(argv[1]) : 100000;
+    uint64_t edge_count = argc > 2 ? std::atoll(argv[2]) : 1000000;
+    uint64_t updates = argc > 3 ? std::atoll(argv[3]) : 1000000;
+    uint32_t remove_percent = argc > 4 ? std::atoi(argv[4]) : 10;
+    const uint64_t check_every = 100000;
+    const int32_t max_weight = 1000000;
+
+    std::vector<CSR_Edge> edges;
+    {
+        Thread_Pool pool;
+        edges = generate_edges(Erdos_Renyi_Generator(vertices, edge_count, 42, max_weight), pool);
+    }
+    std::cout << "vertices: " << vertices << "\tedges: " << edges.size() << "\tupdates: " << updates << std::endl;
+
+    double seconds = 0;
+    Spanning_Forest expected;
+    seconds = measure([&]() { expected = sorting_kruskal(edges, vertices); });
+    std::cout << "Kruskal from scratch:\t" << seconds << " s per update" << std::endl;
+    double kruskal_seconds = seconds;
+
+    Dynamic_MST mst(vertices);
+    seconds = measure([&]() { for (const CSR_Edge& edge : edges) { mst.insert_edge(edge.vertex_from, edge.vertex_to, edge.weight); } });
+    bool correct = mst.total_weight() == expected.total_weight && mst.forest_edge_count() == expected.edges.size();
+    std::cout << "Dynamic, initial inserts:\t" << seconds << " s\tweight: " << mst.total_weight() << (correct ? "" : "\tMISMATCH") << std::endl;
+
+    // Mirror of the live edges for the checks: ids[i] is the Dynamic_MST id of edges[i]. Edge ids follow insertion order.
+    std::vector<uint32_t> ids(edges.size());
+    for (uint32_t i = 0; i < ids.size(); i++) { ids[i] = i; }
+
+    uint64_t inserted = 0, decreased = 0, removed = 0, mismatches = 0;
+    double update_seconds = 0;
+    for (uint64_t done = 0; done < updates;)
+    {
+        uint64_t batch = std::min(check_every, updates - done);
+        update_seconds += measure([&]() {
+            for (uint64_t i = done; i < done + batch; i++)
+            {
+                Edge_Random random(7, i);
+                uint64_t kind = random.below(100);
+                if (kind < remove_percent && !edges.empty())
+                {
+                    uint64_t k = random.below(edges.size());
+                    mst.remove_edge(ids[k]);
+                    edges[k] = edges.back(); ids[k] = ids.back();
+                    edges.pop_back(); ids.pop_back();
+                    removed++;
+                }
+                else if (kind < remove_percent + (100 - remove_percent) / 2 && !edges.empty())
+                {
+                    uint64_t k = random.below(edges.size());
+                    edges[k].weight -= int32_t(random.below(uint64_t(edges[k].weight) + 1));
+                    mst.decrease_weight(ids[k], edges[k].weight);
+                    decreased++;
+                }
+                else
+                {
+                    CSR_Edge edge(uint32_t(random.below(vertices)), uint32_t(random.below(vertices)), random.weight(max_weight));
+                    ids.push_back(mst.insert_edge(edge.vertex_from, edge.vertex_to, edge.weight));
+                    edges.push_back(edge);
+                    inserted++;
+                }
+            }
+            mst.total_weight(); // Pending removals are part of the cost.
+        });
+        done += batch;
+        expected = sorting_kruskal(edges, vertices);
+        mismatches += mst.total_weight() != expected.total_weight || mst.forest_edge_count() != expected.edges.size();
+    }
+    std::cout << "Dynamic, " << updates << " updates:\t" << update_seconds << " s\t" << update_seconds / updates * 1e6 << " us per update"
+              << "\tspeedup over Kruskal: " << kruskal_seconds / (update_seconds / updates) << std::endl;
+    std::cout << "  inserted: " << inserted << "\tdecreased: " << decreased << "\tremoved: " << removed
+              << "\trebuilds: " << mst.rebuild_count() << "\tweight: " << mst.total_weight() << (mismatches == 0 ? "" : "\tMISMATCH") << std::endl;
+    return 0;
+}
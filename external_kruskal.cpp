@@ -0,0 +1,93 @@
+// Minimum spanning forest of an edge list on disk within a memory budget (external_kruskal.h):
+//   ./external_kruskal input.edges|input.csr output.edges [memory_MiB] [undirected]
+// A binary CSR file (graph_io.h) is mapped and streamed; undirected takes each of its edges once.
+// Without file arguments it writes a random edge file, runs with several budgets (many runs and merge passes down
+// to everything in memory) and compares every forest file with Kruskal in memory.
+// Usage: ./external_kruskal [vertices]  (20 edges per vertex)  or  ./external_kruskal input output.edges [memory_MiB] [undirected]
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include "csr_graph.h"
+#include "external_kruskal.h"
+#include "graph_generators.h"
+#include "graph_io.h"
+#include "spanning_tree.h"
+#include "thread_pool.h"
+#include "timing.h"
+
+void report(const External_MST_Statistics& statistics, double seconds)
+{
+    double mib = 1024.0 * 1024.0;
+    std::cout << "  input edges: " << statistics.input_edges << "\truns: " << statistics.runs << "\tmerge passes: " << statistics.merge_passes
+              << "\tforest edges: " << statistics.forest_edges << "\tweight: " << statistics.total_weight << std::endl;
+    std::cout << "  runs: " << statistics.run_seconds << " s\tmerge: " << statistics.merge_seconds << " s\tscan: " << statistics.scan_seconds
+              << " s\ttotal: " << seconds << " s" << std::endl;
+    std::cout << "  read: " << statistics.bytes_read / mib << " MiB\twritten: " << statistics.bytes_written / mib << " MiB\tthroughput: "
+              << (statistics.bytes_read + statistics.bytes_written) / mib / seconds << " MiB/s" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    Thread_Pool pool;
+    if (argc >= 3)
+    {
+        std::string input = argv[1], output = argv[2];
+        uint64_t budget = (argc > 3 ? std::atoll(argv[3]) : 1024) << 20;
+        bool undirected = argc > 4 && std::string(argv[4]) == "undirected";
+        External_MST_Statistics statistics;
+        double seconds = 0;
+        if (input.size() > 4 && input.compare(input.size() - 4, 4, ".csr") == 0)
+        {
+            CSR_Graph graph = map_binary_graph(input);
+            CSR_Edge_Source source(graph, undirected, input);
+            seconds = measure([&]() { statistics = external_kruskal(source, output, pool, budget); });
+        }
+        else
+        {
+            Edge_File_Reader source(input);
+            seconds = measure([&]() { statistics = external_kruskal(source, output, pool, budget); });
+        }
+        std::cout << input << " -> " << output << "\tbudget: " << (budget >> 20) << " MiB" << std::endl;
+        report(statistics, seconds);
+        return 0;
+    }
+
+    uint32_t vertices = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    uint64_t edge_count = 20ull * vertices;
+    const std::string input = "external_kruskal_input.edges", output = "external_kruskal_forest.edges";
+    std::vector<CSR_Edge> edges = generate_edges(Erdos_Renyi_Generator(vertices, edge_count, 42, 1000000), pool);
+    write_edge_file(edges, vertices, input);
+    std::cout << "Vertices: " << vertices << "\tEdges: " << edge_count << "\tfile: " << (edge_count * sizeof(CSR_Edge)) / (1 << 20) << " MiB" << std::endl;
+
+    Spanning_Forest expected;
+    double seconds = measure([&]() { expected = sorting_kruskal(std::move(edges), vertices); });
+    std::cout << "Kruskal in memory:\t" << seconds << " s\tforest edges: " << expected.edges.size() << "\tweight: " << expected.total_weight << std::endl;
+
+    uint64_t union_find_mib = (uint64_t(vertices) * 5 >> 20) + 1;
+    for (uint64_t budget_mib : {union_find_mib + 17, union_find_mib + 64, union_find_mib + 256, uint64_t(4096)})
+    {
+        Edge_File_Reader source(input);
+        External_MST_Statistics statistics;
+        seconds = measure([&]() { statistics = external_kruskal(source, output, pool, budget_mib << 20); });
+
+        // The forest file must hold a forest (no cycle) of the expected size and weight.
+        Edge_File_Reader forest(output);
+        std::vector<CSR_Edge> forest_edges(forest.edge_count());
+        forest.read(forest_edges.data(), forest_edges.size());
+        Union_Find sets(vertices);
+        int64_t weight = 0;
+        bool correct = forest_edges.size() == expected.edges.size() && statistics.total_weight == expected.total_weight;
+        for (const CSR_Edge& edge : forest_edges) { correct &= sets.unite(edge.vertex_from, edge.vertex_to); weight += edge.weight; }
+        correct &= weight == expected.total_weight;
+        std::cout << "External, budget " << budget_mib << " MiB:" << (correct ? "" : "\tMISMATCH") << std::endl;
+        report(statistics, seconds);
+    }
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+    return 0;
+}
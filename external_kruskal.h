@@ -0,0 +1,283 @@
+#ifndef EXTERNAL_KRUSKAL_HPP
+#define EXTERNAL_KRUSKAL_HPP
+
+// Kruskal for edge lists larger than memory: the edges are sorted on disk, only the union-find (5 bytes per vertex)
+// and the I/O buffers live in memory, and the forest is written to an edge file (graph_io.h) as it is found.
+//
+//   1. runs:   read as many edges as fit into the budget, sort them on the Thread_Pool, write them out as one run.
+//   2. merge:  while there are more runs than buffers of at least 4 MiB fit into the budget, merge groups of them
+//              into longer runs (every pass reads and writes everything once).
+//   3. scan:   the last merge is not written: its output goes straight through the union-find, and stops as soon
+//              as the forest has V - 1 edges.
+//
+//     input ──read──► [ sort ] ──write──► run 0, run 1, ... run k-1 ──k-way merge──► union-find ──► forest file
+//
+// Every transfer is one read() or write() of a whole buffer, so a disk sees long sequential streams. With B bytes of
+// budget and N bytes of edges the data crosses the disk 2 + 2 * passes times, passes = ceil(log_fan_in(N / B)) - 1,
+// which is 0 up to N ~ B^2 / 4 MiB (about 250 GB for a 1 GiB budget). Input which fits into one run never touches
+// the disk at all. Runs are temporary edge files next to the output, removed as soon as they are merged.
+//
+// The source is anything with uint64_t read(CSR_Edge* edges, uint64_t count), uint32_t vertex_count(),
+// uint64_t bytes_read() and name(): Edge_File_Reader for an edge file, CSR_Edge_Source for a binary CSR graph mapped by
+// map_binary_graph(), which is read straight from the page cache. Endpoints are checked against vertex_count() while
+// the runs are formed, a corrupted input raises std::runtime_error before the union-find sees it.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "csr_graph.h"
+#include "graph_io.h"
+#include "spanning_tree.h"
+#include "thread_pool.h"
+
+// Edges of a CSR graph in storage order; undirected keeps only from < to, as both directions are stored.
+class CSR_Edge_Source
+{
+    private:
+    const CSR_Graph& graph;
+    bool undirected;
+    std::string source_name;
+    uint32_t vertex = 0;
+    uint64_t position = 0;
+    uint64_t bytes = 0;
+
+    public:
+    CSR_Edge_Source(const CSR_Graph& graph_, bool undirected_, const std::string& name_ = "CSR graph")
+        : graph(graph_), undirected(undirected_), source_name(name_) {}
+
+    const std::string& name() const { return source_name; }
+    uint32_t vertex_count() const { return graph.vertex_count(); }
+    uint64_t bytes_read() const { return bytes; }
+
+    uint64_t read(CSR_Edge* edges, uint64_t count)
+    {
+        const uint64_t* offsets = graph.offset_data();
+        const uint32_t* targets = graph.target_data();
+        const int32_t* weights = graph.is_weighted() ? graph.weight_data() : nullptr;
+        uint64_t filled = 0, start = position;
+        while (filled < count && vertex < graph.vertex_count())
+        {
+            if (position == offsets[vertex + 1]) { vertex++; continue; }
+            uint32_t target = targets[position];
+            if (!undirected || vertex < target) { edges[filled++] = CSR_Edge(vertex, target, weights ? weights[position] : 1); }
+            position++;
+        }
+        bytes += (position - start) * (sizeof(uint32_t) + (weights ? sizeof(int32_t) : 0));
+        return filled;
+    }
+};
+
+struct External_MST_Statistics {
+    public:
+    uint64_t input_edges = 0;
+    uint64_t runs = 0;          // 0 if the input fitted into memory.
+    uint64_t merge_passes = 0;  // Passes which wrote runs; the last merge feeds the union-find instead.
+    uint64_t bytes_read = 0;    // Input and runs.
+    uint64_t bytes_written = 0; // Runs and output.
+    double run_seconds = 0;
+    double merge_seconds = 0;
+    double scan_seconds = 0;    // Last merge, union-find and writing the forest.
+    uint64_t forest_edges = 0;
+    int64_t total_weight = 0;
+};
+
+// Sequential reader of one run with its own buffer.
+class Run_Cursor
+{
+    private:
+    Edge_File_Reader reader;
+    std::vector<CSR_Edge> buffer;
+    uint64_t position = 0;
+    uint64_t filled = 0;
+
+    public:
+    Run_Cursor(const std::string& filename, uint64_t buffer_edges) : reader(filename), buffer(std::max<uint64_t>(buffer_edges, 1)) {}
+
+    // Next edge, false at the end of the run.
+    bool next(CSR_Edge& edge)
+    {
+        if (position == filled)
+        {
+            filled = reader.read(buffer.data(), buffer.size());
+            position = 0;
+            if (filled == 0) { return false; }
+        }
+        edge = buffer[position++];
+        return true;
+    }
+
+    uint64_t bytes_read() const { return reader.bytes_read(); }
+};
+
+// Names of temporary run files; every file ever named is removed at the end, also when the sort fails.
+class Run_Files
+{
+    private:
+    std::string prefix;
+    uint64_t created = 0;
+
+    public:
+    explicit Run_Files(const std::string& prefix_) : prefix(prefix_) {}
+    ~Run_Files() { for (uint64_t i = 0; i < created; i++) { std::remove((prefix + std::to_string(i)).c_str()); } }
+
+    Run_Files(const Run_Files&) = delete;
+    Run_Files& operator=(const Run_Files&) = delete;
+
+    std::string next_name() { return prefix + std::to_string(created++); }
+};
+
+// Merges the runs in weight order into consume(edge), which returns false to stop early. Removes the runs.
+// Returns the bytes read.
+template <typename Consumer>
+uint64_t merge_runs(std::vector<std::string> runs, uint64_t buffer_edges, Consumer consume)
+{
+    std::vector<std::unique_ptr<Run_Cursor>> cursors;
+    std::vector<CSR_Edge> heads(runs.size());
+    using Head = std::pair<int32_t, uint32_t>; // (weight, run); equal weights leave in run order.
+    std::priority_queue<Head, std::vector<Head>, std::greater<Head>> queue;
+    for (uint32_t i = 0; i < runs.size(); i++)
+    {
+        cursors.emplace_back(new Run_Cursor(runs[i], buffer_edges));
+        if (cursors[i]->next(heads[i])) { queue.push({heads[i].weight, i}); }
+    }
+    while (!queue.empty())
+    {
+        uint32_t run = queue.top().second;
+        queue.pop();
+        if (!consume(heads[run])) { break; }
+        if (cursors[run]->next(heads[run])) { queue.push({heads[run].weight, run}); }
+    }
+    uint64_t bytes = 0;
+    for (const auto& cursor : cursors) { bytes += cursor->bytes_read(); }
+    cursors.clear();
+    for (const std::string& name : runs) { std::remove(name.c_str()); }
+    return bytes;
+}
+
+// memory_budget - bytes for the union-find and all buffers together. temporary_prefix - runs are named prefix0,
+// prefix1, ...; empty = output + ".run".
+template <typename Edge_Source>
+External_MST_Statistics external_kruskal(Edge_Source& source, const std::string& output, Thread_Pool& pool,
+                                         uint64_t memory_budget = 1ull << 30, std::string temporary_prefix = "")
+{
+    const uint64_t min_buffer_bytes = 4ull << 20;
+    uint32_t vertices = source.vertex_count();
+    uint64_t union_find_bytes = uint64_t(vertices) * (sizeof(uint32_t) + sizeof(uint8_t));
+    if (memory_budget < union_find_bytes + 4 * min_buffer_bytes)
+    {
+        throw std::invalid_argument("external_kruskal: the memory budget must exceed the union-find by 16 MiB");
+    }
+    uint64_t buffer_edges = (memory_budget - union_find_bytes) / sizeof(CSR_Edge);
+    if (temporary_prefix.empty()) { temporary_prefix = output + ".run"; }
+    auto seconds_since = [](std::chrono::steady_clock::time_point begin) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    };
+    auto by_weight = [](const CSR_Edge& a, const CSR_Edge& b) { return a.weight < b.weight; };
+
+    External_MST_Statistics statistics;
+    Run_Files run_files(temporary_prefix);
+    std::vector<std::string> runs;
+    std::vector<CSR_Edge> in_memory; // The whole input, if it fits into one run.
+
+    // 1. Runs. parallel_sort needs up to half of the buffer as scratch for its merges. The buffer is reserved but
+    // only grows as edges arrive, so a small input does not touch the whole budget.
+    auto begin = std::chrono::steady_clock::now();
+    {
+        uint64_t run_edges = buffer_edges / (pool.size() > 1 ? 2 : 1);
+        std::vector<CSR_Edge> buffer;
+        buffer.reserve(run_edges);
+        while (true)
+        {
+            uint64_t filled = 0;
+            while (filled < run_edges)
+            {
+                if (buffer.size() == filled) { buffer.resize(std::min(run_edges, filled + (1 << 20))); }
+                uint64_t count = source.read(buffer.data() + filled, buffer.size() - filled);
+                if (count == 0) { break; }
+                filled += count;
+            }
+            statistics.input_edges += filled;
+            if (filled == 0) { break; }
+            for (uint64_t i = 0; i < filled; i++)
+            {
+                if (buffer[i].vertex_from >= vertices || buffer[i].vertex_to >= vertices) { throw std::runtime_error(source.name() + " is corrupted"); }
+            }
+            parallel_sort(buffer.begin(), buffer.begin() + filled, by_weight, pool);
+            if (filled < run_edges && runs.empty())
+            {
+                buffer.resize(filled);
+                in_memory.swap(buffer);
+                break;
+            }
+            runs.push_back(run_files.next_name());
+            Edge_File_Writer writer(runs.back(), vertices, 1);
+            writer.write(buffer.data(), filled);
+            writer.close();
+            statistics.bytes_written += writer.bytes_written();
+            statistics.runs++;
+            if (filled < run_edges) { break; }
+        }
+    }
+    statistics.bytes_read += source.bytes_read();
+    statistics.run_seconds = seconds_since(begin);
+
+    // 2. Merge passes until one buffer per run and one for the output are all at least min_buffer_bytes.
+    begin = std::chrono::steady_clock::now();
+    uint64_t fan_in = std::max<uint64_t>(2, buffer_edges * sizeof(CSR_Edge) / min_buffer_bytes - 1);
+    while (runs.size() > fan_in)
+    {
+        std::vector<std::string> merged;
+        for (uint64_t first = 0; first < runs.size(); first += fan_in)
+        {
+            std::vector<std::string> group(runs.begin() + first, runs.begin() + std::min<uint64_t>(first + fan_in, runs.size()));
+            if (group.size() == 1) { merged.push_back(group[0]); continue; } // A lone trailing run is already sorted.
+            uint64_t group_edges = buffer_edges / (group.size() + 1);
+            merged.push_back(run_files.next_name());
+            Edge_File_Writer writer(merged.back(), vertices, group_edges);
+            statistics.bytes_read += merge_runs(group, group_edges, [&](const CSR_Edge& edge) { writer.push(edge); return true; });
+            writer.close();
+            statistics.bytes_written += writer.bytes_written();
+        }
+        runs.swap(merged);
+        statistics.merge_passes++;
+    }
+    statistics.merge_seconds = seconds_since(begin);
+
+    // 3. Last merge into the union-find.
+    begin = std::chrono::steady_clock::now();
+    {
+        Union_Find sets(vertices);
+        uint64_t output_edges = std::min<uint64_t>(buffer_edges / (runs.size() + 1), 1 << 20);
+        Edge_File_Writer writer(output, vertices, std::max<uint64_t>(output_edges, 1));
+        auto consume = [&](const CSR_Edge& edge) {
+            if (sets.unite(edge.vertex_from, edge.vertex_to))
+            {
+                writer.push(edge);
+                statistics.total_weight += edge.weight;
+            }
+            return writer.edge_count() + 1 < vertices;
+        };
+        if (!runs.empty())
+        {
+            statistics.bytes_read += merge_runs(runs, (buffer_edges - output_edges) / runs.size(), consume);
+        }
+        else
+        {
+            for (const CSR_Edge& edge : in_memory) { if (!consume(edge)) { break; } }
+        }
+        writer.close();
+        statistics.forest_edges = writer.edge_count();
+        statistics.bytes_written += writer.bytes_written();
+    }
+    statistics.scan_seconds = seconds_since(begin);
+    return statistics;
+}
+
+#endif // EXTERNAL_KRUSKAL_HPP
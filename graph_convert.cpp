@@ -0,0 +1,93 @@
+// Converts a text graph to the binary CSR format and maps it back:
+//   ./graph_convert input.gr|input.txt|input.mtx output.csr [undirected]     (SNAP for any other extension)
+// Without arguments it writes a random graph as DIMACS, SNAP and Matrix Market, parses all three, checks them against
+// the original, and compares parsing with mapping the binary file.
+// Usage: ./graph_convert [vertices] [edges]  or  ./graph_convert input output.csr [undirected]
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "csr_graph.h"
+#include "graph_generators.h"
+#include "graph_io.h"
+#include "thread_pool.h"
+#include "timing.h"
+
+bool same_graph(const CSR_Graph& a, const CSR_Graph& b)
+{
+    if (a.vertex_count() != b.vertex_count() || a.edge_count() != b.edge_count() || a.is_weighted() != b.is_weighted()) { return false; }
+    for (uint32_t v = 0; v <= a.vertex_count(); v++) { if (a.offset_data()[v] != b.offset_data()[v]) { return false; } }
+    for (uint64_t edge = 0; edge < a.edge_count(); edge++)
+    {
+        if (a.target(edge) != b.target(edge) || a.weight(edge) != b.weight(edge)) { return false; }
+    }
+    return true;
+}
+
+Edge_List read_any(const std::string& filename, Thread_Pool& pool, bool undirected)
+{
+    auto ends_with = [&](const std::string& suffix) {
+        return filename.size() >= suffix.size() && filename.compare(filename.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    if (ends_with(".gr")) { return read_dimacs(filename, pool); }
+    if (ends_with(".mtx")) { return read_matrix_market(filename, pool); }
+    return read_snap(filename, pool, undirected);
+}
+
+int main(int argc, char* argv[])
+{
+    Thread_Pool pool;
+    if (argc >= 3)
+    {
+        Edge_List list;
+        double seconds = measure([&]() { list = read_any(argv[1], pool, argc > 3 && std::string(argv[3]) == "undirected"); });
+        std::cout << "Parsed " << list.edges.size() << " edges in " << seconds << " s" << std::endl;
+        CSR_Graph graph = list.graph();
+        write_binary_graph(graph, argv[2]);
+        CSR_Graph mapped;
+        seconds = measure([&]() { mapped = map_binary_graph(argv[2]); });
+        std::cout << "Mapped " << argv[2] << " in " << seconds << " s" << (same_graph(graph, mapped) ? "" : "\tMISMATCH") << std::endl;
+        return 0;
+    }
+
+    uint32_t vertices = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    uint64_t edge_count = 8ull * vertices;
+    std::vector<CSR_Edge> edges = generate_edges(Erdos_Renyi_Generator(vertices, edge_count, 42, 1000), pool);
+    CSR_Graph weighted = CSR_Graph::from_edges(vertices, edges);
+    CSR_Graph unweighted = CSR_Graph::from_edges(vertices, edges, false, false);
+    std::cout << "Vertices: " << vertices << "\tEdges: " << edge_count << "\tThreads: " << pool.size() << std::endl;
+
+    {
+        std::ofstream gr("graph.gr"), snap("graph.txt"), mtx("graph.mtx");
+        gr << "c random graph\np sp " << vertices << " " << edge_count << "\n";
+        snap << "# random graph\n";
+        mtx << "%%MatrixMarket matrix coordinate integer general\n% random graph\n" << vertices << " " << vertices << " " << edge_count << "\n";
+        for (const CSR_Edge& edge : edges)
+        {
+            gr << "a " << edge.vertex_from + 1 << " " << edge.vertex_to + 1 << " " << edge.weight << "\n";
+            snap << edge.vertex_from << "\t" << edge.vertex_to << "\n";
+            mtx << edge.vertex_from + 1 << " " << edge.vertex_to + 1 << " " << edge.weight << "\n";
+        }
+    }
+
+    Edge_List list;
+    double seconds = measure([&]() { list = read_dimacs("graph.gr", pool); });
+    std::cout << "DIMACS:\t\t\t" << seconds << " s" << (same_graph(list.graph(), weighted) ? "" : "\tMISMATCH") << std::endl;
+    seconds = measure([&]() { list = read_snap("graph.txt", pool); });
+    list.vertices = vertices; // The largest id may not appear in the list.
+    std::cout << "SNAP:\t\t\t" << seconds << " s" << (same_graph(list.graph(), unweighted) ? "" : "\tMISMATCH") << std::endl;
+    seconds = measure([&]() { list = read_matrix_market("graph.mtx", pool); });
+    std::cout << "Matrix Market:\t\t" << seconds << " s" << (same_graph(list.graph(), weighted) ? "" : "\tMISMATCH") << std::endl;
+
+    seconds = measure([&]() { write_binary_graph(weighted, "graph.csr"); });
+    std::cout << "Binary write:\t\t" << seconds << " s\t" << weighted.memory_bytes() / (1 << 20) << " MiB" << std::endl;
+    CSR_Graph mapped;
+    seconds = measure([&]() { mapped = map_binary_graph("graph.csr"); });
+    std::cout << "Binary map:\t\t" << seconds << " s" << (same_graph(mapped, weighted) && mapped.is_view() ? "" : "\tMISMATCH") << std::endl;
+
+    for (const char* filename : {"graph.gr", "graph.txt", "graph.mtx", "graph.csr"}) { std::remove(filename); }
+    return 0;
+}
@@ -0,0 +1,104 @@
+// Writes a synthetic graph from graph_generators.h to the binary CSR format of graph_io.h:
+//   ./graph_generate rmat scale [edge_factor] [seed] output.csr
+//   ./graph_generate grid width height [seed] output.csr          (undirected, weights 1..1000)
+//   ./graph_generate er vertices edges [seed] output.csr
+//   ./graph_generate ba vertices degree [seed] output.csr         (undirected)
+// Without arguments every generator runs once at a moderate size: generation time on the pool and with one thread,
+// the two edge lists must be equal (the output only depends on the seed), plus degree statistics.
+// Usage: ./graph_generate  or  ./graph_generate kind parameters... output.csr
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include "csr_graph.h"
+#include "graph_generators.h"
+#include "graph_io.h"
+#include "thread_pool.h"
+#include "timing.h"
+
+template <typename Generator>
+void run(const char* name, const Generator& generator, Thread_Pool& pool, bool undirected)
+{
+    std::vector<CSR_Edge> edges, single;
+    double seconds = measure([&]() { edges = generate_edges(generator, pool); });
+    Thread_Pool one(1);
+    double single_seconds = measure([&]() { single = generate_edges(generator, one); });
+    bool correct = edges.size() == single.size();
+    for (size_t i = 0; correct && i < edges.size(); i++)
+    {
+        correct = edges[i].vertex_from == single[i].vertex_from && edges[i].vertex_to == single[i].vertex_to && edges[i].weight == single[i].weight;
+    }
+
+    CSR_Graph graph = CSR_Graph::from_edges(generator.vertex_count(), edges, undirected);
+    uint64_t max_degree = 0, isolated = 0;
+    for (uint32_t v = 0; v < graph.vertex_count(); v++)
+    {
+        max_degree = std::max(max_degree, graph.last_edge(v) - graph.first_edge(v));
+        isolated += graph.first_edge(v) == graph.last_edge(v);
+    }
+    std::cout << name << "\tvertices: " << graph.vertex_count() << "\tedges: " << graph.edge_count() << "\tmax degree: " << max_degree
+              << "\tisolated: " << isolated << "\n  " << seconds << " s on " << pool.size() << " threads, " << single_seconds
+              << " s on 1" << (correct ? "" : "\tMISMATCH") << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    Thread_Pool pool;
+    if (argc >= 4)
+    {
+        std::string kind = argv[1], filename = argv[argc - 1];
+        uint64_t first = std::strtoull(argv[2], nullptr, 10);
+        uint64_t second = argc > 4 ? std::strtoull(argv[3], nullptr, 10) : 16;
+        uint64_t seed = argc > 5 ? std::strtoull(argv[4], nullptr, 10) : 1;
+        // Everything but the edge count of er is a 32-bit parameter; the generators reject the rest (empty, too many vertices).
+        if (first > UINT32_MAX || (kind != "er" && second > UINT32_MAX))
+        {
+            std::cerr << "Parameter out of range for " << kind << std::endl;
+            return 1;
+        }
+        double seconds = 0;
+        try
+        {
+            seconds = measure([&]() {
+                if (kind == "rmat") { write_generated_graph(RMAT_Generator(uint32_t(first), uint32_t(second), seed), pool, filename); }
+                else if (kind == "grid") { write_generated_graph(Grid_Generator(uint32_t(first), uint32_t(second), seed), pool, filename, true); }
+                else if (kind == "er") { write_generated_graph(Erdos_Renyi_Generator(uint32_t(first), second, seed), pool, filename); }
+                else if (kind == "ba") { write_generated_graph(Barabasi_Albert_Generator(uint32_t(first), uint32_t(second), seed), pool, filename, true); }
+                else { std::cerr << "Unknown generator: " << kind << std::endl; std::exit(1); }
+            });
+        }
+        catch (const std::invalid_argument& error)
+        {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
+        CSR_Graph graph = map_binary_graph(filename);
+        std::cout << "Wrote " << filename << " in " << seconds << " s\tvertices: " << graph.vertex_count()
+                  << "\tedges: " << graph.edge_count() << std::endl;
+        return 0;
+    }
+
+    run("R-MAT, scale 18", RMAT_Generator(18), pool, false);
+    run("Grid 1000 x 1000", Grid_Generator(1000, 1000), pool, true);
+    run("Erdos-Renyi", Erdos_Renyi_Generator(1 << 20, 8u << 20), pool, false);
+    run("Barabasi-Albert", Barabasi_Albert_Generator(1 << 20, 4), pool, true);
+
+    const char* filename = "generated.csr";
+    RMAT_Generator generator(16, 16, 7, 1000);
+    write_generated_graph(generator, pool, filename);
+    CSR_Graph expected = generate_graph(generator, pool);
+    CSR_Graph mapped = map_binary_graph(filename);
+    bool correct = expected.edge_count() == mapped.edge_count();
+    for (uint64_t edge = 0; correct && edge < expected.edge_count(); edge++)
+    {
+        correct = expected.target(edge) == mapped.target(edge) && expected.weight(edge) == mapped.weight(edge);
+    }
+    std::cout << "Written and mapped back:\t" << filename << (correct ? "" : "\tMISMATCH") << std::endl;
+    std::remove(filename);
+
+    return 0;
+}
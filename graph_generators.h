@@ -0,0 +1,217 @@
+#ifndef GRAPH_GENERATORS_HPP
+#define GRAPH_GENERATORS_HPP
+
+// Seeded synthetic graphs for benchmarks. Every generator is a random-access edge list: edge(i) depends only on
+// the seed and i, through its own small random stream. Edges can therefore be produced by any number of threads
+// in any order, and the result is the same list for the same seed on every machine and every thread count.
+//
+//   RMAT_Generator           - R-MAT / Kronecker (Graph500): 2^scale vertices, edge_factor * 2^scale edges; every edge
+//                              picks one quadrant of the adjacency matrix per bit with probabilities a, b, c, 1-a-b-c,
+//                              then ids are scrambled by a seeded permutation. Skewed degrees, small diameter.
+//   Grid_Generator           - width x height grid, edges to the right and lower neighbour with random weights.
+//                              Road-like: degree <= 4, diameter ~ width + height.
+//   Erdos_Renyi_Generator    - G(n, m): m edges with both ends uniform.
+//   Barabasi_Albert_Generator - preferential attachment, every new vertex brings `degree` edges. Sequentially a target
+//                              is chosen with probability proportional to its degree. Here (Sanders & Schulz) the list of
+//                              edge ends is used instead: end 2i is the source of edge i, end 2i + 1 (its target) copies a
+//                              uniformly chosen earlier end. Following the copies computes any edge on its own.
+//
+// generate_edges() fills an edge list on a Thread_Pool, write_generated_graph() turns it into the binary CSR file
+// of graph_io.h. Weights are uniform in 1..max_weight (generators take max_weight = 1 for unweighted use).
+// Vertex ids are 32-bit: constructors throw std::invalid_argument for empty graphs or more than 2^32 - 1 vertices.
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "csr_graph.h"
+#include "graph_io.h"
+#include "thread_pool.h"
+
+// splitmix64: statistically good, one multiply-xorshift chain per number, seeded per edge.
+struct Edge_Random {
+    public:
+    uint64_t state;
+
+    Edge_Random(uint64_t seed, uint64_t index) : state(seed ^ (index * 0x9e3779b97f4a7c15ull)) { next(); }
+
+    uint64_t next()
+    {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, bound), without modulo bias worth mentioning for bound << 2^64.
+    uint64_t below(uint64_t bound) { return uint64_t((unsigned __int128)next() * bound >> 64); }
+    double uniform() { return (next() >> 11) * 0x1.0p-53; }
+    int32_t weight(int32_t max_weight) { return int32_t(1 + below(uint64_t(max_weight))); }
+};
+
+class RMAT_Generator
+{
+    private:
+    uint32_t scale;
+    uint64_t edges;
+    double a, b, c;
+    int32_t max_weight;
+    uint64_t seed;
+    std::vector<uint32_t> permutation;
+
+    public:
+    // Graph500 defaults: edge_factor 16, a = 0.57, b = c = 0.19.
+    RMAT_Generator(uint32_t scale_, uint32_t edge_factor = 16, uint64_t seed_ = 1, int32_t max_weight_ = 1,
+                   double a_ = 0.57, double b_ = 0.19, double c_ = 0.19)
+        : scale(scale_), edges(0), a(a_), b(b_), c(c_), max_weight(max_weight_), seed(seed_)
+    {
+        if (scale_ > 31) { throw std::invalid_argument("RMAT_Generator: scale must be at most 31"); }
+        edges = uint64_t(edge_factor) << scale_;
+        permutation.resize(uint64_t(1) << scale_);
+        for (uint32_t v = 0; v < permutation.size(); v++) { permutation[v] = v; }
+        Edge_Random random(seed, UINT64_MAX);
+        for (uint64_t v = permutation.size(); v > 1; v--) { std::swap(permutation[v - 1], permutation[random.below(v)]); }
+    }
+
+    uint32_t vertex_count() const { return uint32_t(permutation.size()); }
+    uint64_t edge_count() const { return edges; }
+
+    CSR_Edge edge(uint64_t index) const
+    {
+        Edge_Random random(seed, index);
+        uint32_t from = 0, to = 0;
+        for (uint32_t bit = 0; bit < scale; bit++)
+        {
+            double r = random.uniform();
+            bool lower = r >= a + b;                  // Quadrants c and d: the source bit is 1.
+            bool right = lower ? r >= a + b + c : r >= a; // Quadrants b and d: the target bit is 1.
+            from = (from << 1) | lower;
+            to = (to << 1) | right;
+        }
+        return CSR_Edge(permutation[from], permutation[to], random.weight(max_weight));
+    }
+};
+
+class Grid_Generator
+{
+    private:
+    uint32_t width;
+    uint32_t height;
+    int32_t max_weight;
+    uint64_t seed;
+    uint64_t horizontal; // Edges v -> v + 1 come first, then edges v -> v + width.
+
+    public:
+    Grid_Generator(uint32_t width_, uint32_t height_, uint64_t seed_ = 1, int32_t max_weight_ = 1000)
+        : width(width_), height(height_), max_weight(max_weight_), seed(seed_)
+    {
+        if (width == 0 || height == 0 || uint64_t(width) * height > UINT32_MAX)
+        {
+            throw std::invalid_argument("Grid_Generator: width and height must be positive and width * height below 2^32");
+        }
+        horizontal = (uint64_t(width) - 1) * height;
+    }
+
+    uint32_t vertex_count() const { return uint32_t(uint64_t(width) * height); }
+    uint64_t edge_count() const { return horizontal + uint64_t(width) * (uint64_t(height) - 1); }
+
+    CSR_Edge edge(uint64_t index) const
+    {
+        Edge_Random random(seed, index);
+        if (index < horizontal)
+        {
+            uint32_t v = uint32_t(index / (width - 1) * width + index % (width - 1));
+            return CSR_Edge(v, v + 1, random.weight(max_weight));
+        }
+        uint32_t v = uint32_t(index - horizontal);
+        return CSR_Edge(v, v + width, random.weight(max_weight));
+    }
+};
+
+class Erdos_Renyi_Generator
+{
+    private:
+    uint32_t vertices;
+    uint64_t edges;
+    int32_t max_weight;
+    uint64_t seed;
+
+    public:
+    Erdos_Renyi_Generator(uint32_t vertices_, uint64_t edges_, uint64_t seed_ = 1, int32_t max_weight_ = 1)
+        : vertices(vertices_), edges(edges_), max_weight(max_weight_), seed(seed_)
+    {
+        if (vertices == 0 && edges > 0) { throw std::invalid_argument("Erdos_Renyi_Generator: edges need vertices"); }
+    }
+
+    uint32_t vertex_count() const { return vertices; }
+    uint64_t edge_count() const { return edges; }
+
+    CSR_Edge edge(uint64_t index) const
+    {
+        Edge_Random random(seed, index);
+        uint32_t from = uint32_t(random.below(vertices));
+        uint32_t to = uint32_t(random.below(vertices));
+        return CSR_Edge(from, to, random.weight(max_weight));
+    }
+};
+
+class Barabasi_Albert_Generator
+{
+    private:
+    uint32_t vertices;
+    uint32_t degree;
+    int32_t max_weight;
+    uint64_t seed;
+
+    // End 2i is the source of edge i (vertex i / degree + 1, vertex 0 is the seed), end 2i + 1 a copy of an earlier end.
+    uint32_t end_vertex(uint64_t end) const
+    {
+        while (end % 2 == 1)
+        {
+            uint64_t index = end / 2;
+            if (index == 0) { return 0; }
+            end = Edge_Random(seed, index).below(2 * index);
+        }
+        return uint32_t(end / 2 / degree + 1);
+    }
+
+    public:
+    Barabasi_Albert_Generator(uint32_t vertices_, uint32_t degree_, uint64_t seed_ = 1, int32_t max_weight_ = 1)
+        : vertices(vertices_), degree(degree_), max_weight(max_weight_), seed(seed_)
+    {
+        if (vertices == 0) { throw std::invalid_argument("Barabasi_Albert_Generator: vertices must be positive"); }
+    }
+
+    uint32_t vertex_count() const { return vertices; }
+    uint64_t edge_count() const { return uint64_t(vertices - 1) * degree; }
+
+    CSR_Edge edge(uint64_t index) const
+    {
+        Edge_Random random(seed ^ 0x5bd1e995u, index); // Weights use a stream independent of the copies.
+        return CSR_Edge(end_vertex(2 * index), end_vertex(2 * index + 1), random.weight(max_weight));
+    }
+};
+
+template <typename Generator>
+std::vector<CSR_Edge> generate_edges(const Generator& generator, Thread_Pool& pool)
+{
+    std::vector<CSR_Edge> edges(generator.edge_count());
+    pool.parallel_for(0, edges.size(), [&](uint64_t i, int) { edges[i] = generator.edge(i); }, 1 << 14);
+    return edges;
+}
+
+template <typename Generator>
+CSR_Graph generate_graph(const Generator& generator, Thread_Pool& pool, bool undirected = false, bool weighted = true)
+{
+    return CSR_Graph::from_edges(generator.vertex_count(), generate_edges(generator, pool), undirected, weighted);
+}
+
+template <typename Generator>
+void write_generated_graph(const Generator& generator, Thread_Pool& pool, const std::string& filename,
+                           bool undirected = false, bool weighted = true)
+{
+    write_binary_graph(generate_graph(generator, pool, undirected, weighted), filename);
+}
+
+#endif // GRAPH_GENERATORS_HPP
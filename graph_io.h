@@ -0,0 +1,602 @@
+#ifndef GRAPH_IO_HPP
+#define GRAPH_IO_HPP
+
+// Reading and writing graphs.
+//
+// Text edge lists, parsed by all threads of a Thread_Pool:
+//   read_dimacs()         - DIMACS shortest path format (.gr): "c comment", "p sp V E", "a u v w", vertices 1..V, directed.
+//   read_snap()           - SNAP edge list: "# comment", "u v" per line, vertices from 0, V = largest id + 1.
+//   read_matrix_market()  - Matrix Market coordinate format (.mtx): banner, "% comment", "rows columns entries",
+//                           "i j [value]", indices from 1. symmetric -> undirected, pattern -> unweighted,
+//                           real values are rounded to the nearest integer weight.
+// The file is memory-mapped and cut into chunks at line boundaries, every chunk is parsed by one thread with
+// a hand-written number parser (no iostreams, no locale, no allocation per line), and the chunks are joined in order,
+// so the edge list is exactly the order of the file.
+//
+// Binary CSR file, version 1: a 64-byte header followed by the arrays of CSR_Graph exactly as they are in memory,
+// each aligned to 64 bytes:
+//
+//     [ header: magic "CSRG", version, flags, V, E, positions of the arrays ][ offsets ][ targets ][ weights ]
+//
+// map_binary_graph() maps the file and returns a CSR_Graph view pointing right into the mapping: nothing is
+// copied, pages are loaded by the OS when they are first touched. By default one validating pass reads the file;
+// without it (validate = false, trusted files) opening a graph of any size takes milliseconds. The mapping lives as long as the graph or any copy of it. Numbers are stored in the byte order
+// of the machine; a file from a machine with the other byte order fails the magic check.
+//
+// Binary edge file: a plain list of CSR_Edge records behind a small header, written and read as a stream (see below).
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "csr_graph.h"
+#include "thread_pool.h"
+
+// Read-only mapping of a whole file.
+class Mapped_File
+{
+    private:
+    const char* bytes = nullptr;
+    uint64_t length = 0;
+
+    public:
+    explicit Mapped_File(const std::string& filename)
+    {
+        int descriptor = ::open(filename.c_str(), O_RDONLY);
+        if (descriptor < 0) { throw std::runtime_error("Cannot open " + filename); }
+        struct stat status;
+        if (::fstat(descriptor, &status) != 0) { ::close(descriptor); throw std::runtime_error("Cannot stat " + filename); }
+        length = uint64_t(status.st_size);
+        if (length > 0)
+        {
+            void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (mapping == MAP_FAILED) { ::close(descriptor); throw std::runtime_error("Cannot map " + filename); }
+            bytes = static_cast<const char*>(mapping);
+        }
+        ::close(descriptor); // The mapping stays valid without the descriptor.
+    }
+
+    ~Mapped_File()
+    {
+        if (bytes) { ::munmap(const_cast<char*>(bytes), length); }
+    }
+
+    Mapped_File(const Mapped_File&) = delete;
+    Mapped_File& operator=(const Mapped_File&) = delete;
+
+    const char* data() const { return bytes; }
+    uint64_t size() const { return length; }
+};
+
+struct Edge_List {
+    public:
+    uint32_t vertices = 0;
+    std::vector<CSR_Edge> edges;
+    bool undirected = false;
+    bool weighted = true;
+
+    CSR_Graph graph() const { return CSR_Graph::from_edges(vertices, edges, undirected, weighted); }
+};
+
+// Cursor over a part of a text. Every reader stops at end, nothing is ever read past it.
+struct Text_Cursor {
+    public:
+    const char* position;
+    const char* end;
+
+    bool at_end() const { return position == end; }
+    bool at_line_end() const { return position == end || *position == '\n' || *position == '\r'; }
+
+    void skip_blanks()
+    {
+        while (position < end && (*position == ' ' || *position == '\t')) { position++; }
+    }
+
+    // Moves to the beginning of the next line.
+    void skip_line()
+    {
+        const char* newline = static_cast<const char*>(std::memchr(position, '\n', end - position));
+        position = newline ? newline + 1 : end;
+    }
+
+    // The rest of the line must be blank; moves to the next line.
+    bool finish_line()
+    {
+        skip_blanks();
+        if (position < end && *position == '\r') { position++; }
+        if (position < end && *position != '\n') { return false; }
+        if (position < end) { position++; }
+        return true;
+    }
+
+    // False for a number above UINT64_MAX, so an over-long id can not wrap into range.
+    bool read_unsigned(uint64_t& value)
+    {
+        skip_blanks();
+        if (position == end || *position < '0' || *position > '9') { return false; }
+        value = 0;
+        while (position < end && *position >= '0' && *position <= '9')
+        {
+            uint64_t digit = uint64_t(*position++ - '0');
+            if (value > (UINT64_MAX - digit) / 10) { return false; }
+            value = value * 10 + digit;
+        }
+        return true;
+    }
+
+    bool read_signed(int64_t& value)
+    {
+        skip_blanks();
+        bool negative = position < end && *position == '-';
+        if (position < end && (*position == '-' || *position == '+')) { position++; }
+        uint64_t magnitude;
+        if (!read_unsigned(magnitude) || magnitude > uint64_t(INT64_MAX) + negative) { return false; }
+        value = negative ? int64_t(0 - magnitude) : int64_t(magnitude);
+        return true;
+    }
+
+    // Decimal number with optional sign, fraction and exponent: -12.5e3
+    bool read_real(double& value)
+    {
+        skip_blanks();
+        bool negative = position < end && *position == '-';
+        if (position < end && (*position == '-' || *position == '+')) { position++; }
+        double result = 0;
+        int digits = 0;
+        while (position < end && *position >= '0' && *position <= '9') { result = result * 10 + (*position++ - '0'); digits++; }
+        if (position < end && *position == '.')
+        {
+            position++;
+            double scale = 0.1;
+            while (position < end && *position >= '0' && *position <= '9') { result += (*position++ - '0') * scale; scale /= 10; digits++; }
+        }
+        if (digits == 0) { return false; }
+        if (position < end && (*position == 'e' || *position == 'E'))
+        {
+            position++;
+            int64_t exponent;
+            if (!read_signed(exponent)) { return false; }
+            result *= std::pow(10.0, double(exponent));
+        }
+        value = negative ? -result : result;
+        return true;
+    }
+};
+
+// Splits [first, last) into chunks starting at line beginnings and calls parse_line(cursor, edges) for every line
+// of a chunk on the pool. parse_line consumes one whole line and returns false if it is malformed.
+template <typename Line_Parser>
+std::vector<CSR_Edge> parse_edge_lines(const char* first, const char* last, Thread_Pool& pool, Line_Parser parse_line,
+                                       const std::string& filename)
+{
+    const uint64_t chunks = std::max<uint64_t>(1, std::min<uint64_t>(uint64_t(pool.size()) * 8, (last - first) / 4096 + 1));
+    std::vector<const char*> bounds(chunks + 1, last);
+    bounds[0] = first;
+    for (uint64_t i = 1; i < chunks; i++)
+    {
+        const char* position = std::max(bounds[i - 1], first + (last - first) * i / chunks);
+        while (position < last && position > first && position[-1] != '\n') { position++; }
+        bounds[i] = position;
+    }
+
+    std::vector<std::vector<CSR_Edge>> parts(chunks);
+    std::vector<const char*> malformed(chunks, nullptr);
+    pool.parallel_for(0, chunks, [&](uint64_t i, int) {
+        Text_Cursor cursor{bounds[i], bounds[i + 1]};
+        while (!cursor.at_end())
+        {
+            const char* line = cursor.position;
+            if (!parse_line(cursor, parts[i])) { malformed[i] = line; return; }
+        }
+    }, 1);
+
+    for (const char* line : malformed)
+    {
+        if (line)
+        {
+            const char* line_end = static_cast<const char*>(std::memchr(line, '\n', last - line));
+            throw std::runtime_error(filename + ": malformed line \"" + std::string(line, line_end ? line_end : last) + "\"");
+        }
+    }
+
+    std::vector<uint64_t> start(chunks + 1, 0);
+    for (uint64_t i = 0; i < chunks; i++) { start[i + 1] = start[i] + parts[i].size(); }
+    std::vector<CSR_Edge> edges(start[chunks]);
+    pool.parallel_for(0, chunks, [&](uint64_t i, int) {
+        std::copy(parts[i].begin(), parts[i].end(), edges.begin() + start[i]);
+        std::vector<CSR_Edge>().swap(parts[i]);
+    }, 1);
+    return edges;
+}
+
+inline Edge_List read_dimacs(const std::string& filename, Thread_Pool& pool)
+{
+    Mapped_File file(filename);
+    Text_Cursor cursor{file.data(), file.data() + file.size()};
+    Edge_List result;
+
+    // Problem line first, arcs after it.
+    uint64_t vertices = 0, arcs = 0;
+    while (true)
+    {
+        if (cursor.at_end()) { throw std::runtime_error(filename + ": no \"p sp V E\" line"); }
+        if (*cursor.position == 'p')
+        {
+            cursor.position++;
+            cursor.skip_blanks();
+            if (cursor.end - cursor.position < 2 || std::strncmp(cursor.position, "sp", 2) != 0) { throw std::runtime_error(filename + ": not a shortest path problem"); }
+            cursor.position += 2;
+            if (!cursor.read_unsigned(vertices) || !cursor.read_unsigned(arcs) || !cursor.finish_line() || vertices > UINT32_MAX)
+            {
+                throw std::runtime_error(filename + ": malformed problem line");
+            }
+            break;
+        }
+        cursor.skip_line();
+    }
+    result.vertices = uint32_t(vertices);
+
+    result.edges = parse_edge_lines(cursor.position, cursor.end, pool, [&](Text_Cursor& line, std::vector<CSR_Edge>& edges) {
+        if (line.at_line_end() || *line.position == 'c') { line.skip_line(); return true; }
+        if (*line.position != 'a') { return false; }
+        line.position++;
+        uint64_t from, to;
+        int64_t weight;
+        if (!line.read_unsigned(from) || !line.read_unsigned(to) || !line.read_signed(weight) || !line.finish_line()) { return false; }
+        if (from == 0 || to == 0 || from > vertices || to > vertices || weight < INT32_MIN || weight > INT32_MAX) { return false; }
+        edges.emplace_back(uint32_t(from - 1), uint32_t(to - 1), int32_t(weight));
+        return true;
+    }, filename);
+    if (result.edges.size() != arcs) { throw std::runtime_error(filename + ": the problem line promises " + std::to_string(arcs) + " arcs"); }
+    return result;
+}
+
+inline Edge_List read_snap(const std::string& filename, Thread_Pool& pool, bool undirected = false)
+{
+    Mapped_File file(filename);
+    Edge_List result;
+    result.undirected = undirected;
+    result.weighted = false;
+
+    result.edges = parse_edge_lines(file.data(), file.data() + file.size(), pool, [](Text_Cursor& line, std::vector<CSR_Edge>& edges) {
+        line.skip_blanks();
+        if (line.at_line_end() || *line.position == '#' || *line.position == '%') { line.skip_line(); return true; }
+        uint64_t from, to;
+        if (!line.read_unsigned(from) || !line.read_unsigned(to) || !line.finish_line()) { return false; }
+        if (from >= UINT32_MAX || to >= UINT32_MAX) { return false; }
+        edges.emplace_back(uint32_t(from), uint32_t(to));
+        return true;
+    }, filename);
+
+    std::vector<uint32_t> largest(pool.size(), 0);
+    pool.parallel_for(0, result.edges.size(), [&](uint64_t i, int thread_index) {
+        largest[thread_index] = std::max({largest[thread_index], result.edges[i].vertex_from + 1, result.edges[i].vertex_to + 1});
+    }, 1 << 16);
+    result.vertices = *std::max_element(largest.begin(), largest.end());
+    return result;
+}
+
+inline Edge_List read_matrix_market(const std::string& filename, Thread_Pool& pool)
+{
+    Mapped_File file(filename);
+    Text_Cursor cursor{file.data(), file.data() + file.size()};
+    Edge_List result;
+
+    const char* banner_end = static_cast<const char*>(std::memchr(cursor.position, '\n', cursor.end - cursor.position));
+    std::string banner(cursor.position, banner_end ? banner_end : cursor.end);
+    std::transform(banner.begin(), banner.end(), banner.begin(), [](char c) { return char(std::tolower(c)); });
+    auto has = [&](const char* word) { return banner.find(word) != std::string::npos; };
+    if (banner.compare(0, 14, "%%matrixmarket") != 0 || !has(" matrix") || !has(" coordinate"))
+    {
+        throw std::runtime_error(filename + ": not a Matrix Market coordinate file");
+    }
+    if (has(" complex") || has(" skew-symmetric") || has(" hermitian")) { throw std::runtime_error(filename + ": unsupported matrix type"); }
+    bool pattern = has(" pattern");
+    result.weighted = !pattern;
+    result.undirected = has(" symmetric");
+    cursor.skip_line();
+
+    uint64_t rows, columns, entries;
+    while (!cursor.at_end() && (*cursor.position == '%' || cursor.at_line_end())) { cursor.skip_line(); }
+    if (!cursor.read_unsigned(rows) || !cursor.read_unsigned(columns) || !cursor.read_unsigned(entries) || !cursor.finish_line()
+        || std::max(rows, columns) > UINT32_MAX)
+    {
+        throw std::runtime_error(filename + ": malformed size line");
+    }
+    result.vertices = uint32_t(std::max(rows, columns));
+
+    result.edges = parse_edge_lines(cursor.position, cursor.end, pool, [&](Text_Cursor& line, std::vector<CSR_Edge>& edges) {
+        line.skip_blanks();
+        if (line.at_line_end() || *line.position == '%') { line.skip_line(); return true; }
+        uint64_t row, column;
+        double value = 1;
+        if (!line.read_unsigned(row) || !line.read_unsigned(column) || (!pattern && !line.read_real(value)) || !line.finish_line()) { return false; }
+        value = std::round(value);
+        if (row == 0 || column == 0 || row > rows || column > columns || !(value >= INT32_MIN && value <= INT32_MAX)) { return false; }
+        edges.emplace_back(uint32_t(row - 1), uint32_t(column - 1), int32_t(value));
+        return true;
+    }, filename);
+    if (result.edges.size() != entries) { throw std::runtime_error(filename + ": the size line promises " + std::to_string(entries) + " entries"); }
+    return result;
+}
+
+struct Binary_Graph_Header {
+    public:
+    static constexpr uint32_t magic_value = 0x47525343; // "CSRG"
+    static constexpr uint32_t current_version = 1;
+    static constexpr uint32_t weighted_flag = 1;
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t flags;
+    uint32_t vertices;
+    uint64_t edges;
+    uint64_t offsets_position;
+    uint64_t targets_position;
+    uint64_t weights_position; // 0 for unweighted graphs.
+    uint64_t reserved[2];
+};
+static_assert(sizeof(Binary_Graph_Header) == 64, "the header is part of the file format");
+
+inline void write_binary_graph(const CSR_Graph& graph, const std::string& filename)
+{
+    auto aligned = [](uint64_t position) { return (position + 63) / 64 * 64; };
+    Binary_Graph_Header header{};
+    header.magic = Binary_Graph_Header::magic_value;
+    header.version = Binary_Graph_Header::current_version;
+    header.flags = graph.is_weighted() ? Binary_Graph_Header::weighted_flag : 0;
+    header.vertices = graph.vertex_count();
+    header.edges = graph.edge_count();
+    header.offsets_position = sizeof(Binary_Graph_Header);
+    header.targets_position = aligned(header.offsets_position + (uint64_t(graph.vertex_count()) + 1) * sizeof(uint64_t));
+    header.weights_position = graph.is_weighted() ? aligned(header.targets_position + graph.edge_count() * sizeof(uint32_t)) : 0;
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) { throw std::runtime_error("Cannot open " + filename); }
+    auto write_at = [&](uint64_t position, const void* data, uint64_t bytes) {
+        static const char zeros[64] = {};
+        file.write(zeros, position - uint64_t(file.tellp()));
+        file.write(static_cast<const char*>(data), bytes);
+    };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    write_at(header.offsets_position, graph.offset_data(), (uint64_t(graph.vertex_count()) + 1) * sizeof(uint64_t));
+    write_at(header.targets_position, graph.target_data(), graph.edge_count() * sizeof(uint32_t));
+    if (graph.is_weighted()) { write_at(header.weights_position, graph.weight_data(), graph.edge_count() * sizeof(int32_t)); }
+    if (!file) { throw std::runtime_error("Cannot write " + filename); }
+}
+
+// Zero-copy: the returned graph is a view into the mapped file. The header is always checked: every array must lie
+// inside the file (compared without sums which could wrap around) and be aligned for its type. validate = true also
+// reads the whole file once, O(V + E): offsets must not decrease and every target must be < V, so no engine can be
+// sent outside the arrays by a damaged or hostile file. Pass false for trusted files to keep opening in milliseconds.
+inline CSR_Graph map_binary_graph(const std::string& filename, bool validate = true)
+{
+    std::shared_ptr<Mapped_File> file = std::make_shared<Mapped_File>(filename);
+    Binary_Graph_Header header;
+    if (file->size() < sizeof(header)) { throw std::runtime_error(filename + " is not a binary graph"); }
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (header.magic != Binary_Graph_Header::magic_value) { throw std::runtime_error(filename + " is not a binary graph"); }
+    if (header.version != Binary_Graph_Header::current_version)
+    {
+        throw std::runtime_error(filename + ": unsupported version " + std::to_string(header.version));
+    }
+
+    bool weighted = header.flags & Binary_Graph_Header::weighted_flag;
+    uint64_t size = file->size();
+    auto fits = [size](uint64_t position, uint64_t count, uint64_t element) { return position <= size && count <= (size - position) / element; };
+    if (!fits(header.offsets_position, uint64_t(header.vertices) + 1, sizeof(uint64_t)) || !fits(header.targets_position, header.edges, sizeof(uint32_t))
+        || (weighted && !fits(header.weights_position, header.edges, sizeof(int32_t))))
+    {
+        throw std::runtime_error(filename + " is truncated");
+    }
+    // The mapping starts on a page boundary, so aligned positions give aligned arrays.
+    if (header.offsets_position % alignof(uint64_t) != 0 || header.targets_position % alignof(uint32_t) != 0
+        || (weighted && header.weights_position % alignof(int32_t) != 0))
+    {
+        throw std::runtime_error(filename + " is corrupted");
+    }
+
+    const uint64_t* offsets = reinterpret_cast<const uint64_t*>(file->data() + header.offsets_position);
+    if (offsets[0] != 0 || offsets[header.vertices] != header.edges) { throw std::runtime_error(filename + " is corrupted"); }
+    const uint32_t* targets = reinterpret_cast<const uint32_t*>(file->data() + header.targets_position);
+    const int32_t* weights = weighted ? reinterpret_cast<const int32_t*>(file->data() + header.weights_position) : nullptr;
+    if (validate)
+    {
+        for (uint32_t v = 0; v < header.vertices; v++)
+        {
+            if (offsets[v] > offsets[v + 1]) { throw std::runtime_error(filename + " is corrupted"); }
+        }
+        for (uint64_t edge = 0; edge < header.edges; edge++)
+        {
+            if (targets[edge] >= header.vertices) { throw std::runtime_error(filename + " is corrupted"); }
+        }
+    }
+    return CSR_Graph::view(header.vertices, offsets, targets, weights, file);
+}
+
+// Binary edge file, version 1: a 32-byte header followed by the edges as CSR_Edge records (from, to, weight; 12 bytes):
+//
+//     [ header: magic "EDGL", version, V, E ][ edge 0 ][ edge 1 ] ... [ edge E-1 ]
+//
+// Made for edge lists larger than memory: Edge_File_Writer and Edge_File_Reader stream them through the caller's
+// buffers with large sequential read() / write() calls, and count the bytes they move.
+
+struct Edge_File_Header {
+    public:
+    static constexpr uint32_t magic_value = 0x4C474445; // "EDGL"
+    static constexpr uint32_t current_version = 1;
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vertices;
+    uint32_t reserved0;
+    uint64_t edges;
+    uint64_t reserved1;
+};
+static_assert(sizeof(Edge_File_Header) == 32, "the header is part of the file format");
+static_assert(sizeof(CSR_Edge) == 12, "edge records are part of the file format");
+
+class Edge_File_Writer
+{
+    private:
+    std::string filename;
+    int descriptor = -1;
+    std::vector<CSR_Edge> buffer;
+    uint64_t capacity;
+    uint32_t vertices;
+    uint64_t edges = 0;
+    uint64_t bytes = 0;
+
+    void write_bytes(const void* data, uint64_t count)
+    {
+        const char* position = static_cast<const char*>(data);
+        while (count > 0)
+        {
+            ssize_t done = ::write(descriptor, position, count);
+            if (done <= 0) { throw std::runtime_error("Cannot write " + filename); }
+            position += done;
+            count -= uint64_t(done);
+            bytes += uint64_t(done);
+        }
+    }
+
+    void flush()
+    {
+        write_bytes(buffer.data(), buffer.size() * sizeof(CSR_Edge));
+        buffer.clear();
+    }
+
+    public:
+    // buffer_edges - edges collected by push() before one write().
+    Edge_File_Writer(const std::string& filename_, uint32_t vertices_, uint64_t buffer_edges = 1 << 20)
+        : filename(filename_), capacity(std::max<uint64_t>(buffer_edges, 1)), vertices(vertices_)
+    {
+        descriptor = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (descriptor < 0) { throw std::runtime_error("Cannot open " + filename); }
+        Edge_File_Header header{}; // The edge count is filled in by close().
+        write_bytes(&header, sizeof(header));
+    }
+
+    ~Edge_File_Writer()
+    {
+        if (descriptor >= 0) { ::close(descriptor); } // Without close() the file has no valid header.
+    }
+
+    Edge_File_Writer(const Edge_File_Writer&) = delete;
+    Edge_File_Writer& operator=(const Edge_File_Writer&) = delete;
+
+    void push(const CSR_Edge& edge)
+    {
+        if (buffer.empty()) { buffer.reserve(capacity); } // Only writers which push pay for the buffer.
+        buffer.push_back(edge);
+        edges++;
+        if (buffer.size() == capacity) { flush(); }
+    }
+
+    // Large blocks go straight to the file, without a copy into the buffer.
+    void write(const CSR_Edge* block, uint64_t count)
+    {
+        flush();
+        write_bytes(block, count * sizeof(CSR_Edge));
+        edges += count;
+    }
+
+    void close()
+    {
+        flush();
+        Edge_File_Header header{};
+        header.magic = Edge_File_Header::magic_value;
+        header.version = Edge_File_Header::current_version;
+        header.vertices = vertices;
+        header.edges = edges;
+        bool written = ::pwrite(descriptor, &header, sizeof(header), 0) == ssize_t(sizeof(header));
+        written &= ::close(descriptor) == 0;
+        descriptor = -1;
+        if (!written) { throw std::runtime_error("Cannot write " + filename); }
+    }
+
+    uint64_t edge_count() const { return edges; }
+    uint64_t bytes_written() const { return bytes; }
+};
+
+class Edge_File_Reader
+{
+    private:
+    std::string filename;
+    int descriptor = -1;
+    Edge_File_Header header;
+    uint64_t remaining;
+    uint64_t bytes = 0;
+
+    uint64_t read_bytes(void* data, uint64_t count)
+    {
+        char* position = static_cast<char*>(data);
+        uint64_t total = 0;
+        while (total < count)
+        {
+            ssize_t done = ::read(descriptor, position + total, count - total);
+            if (done < 0) { throw std::runtime_error("Cannot read " + filename); }
+            if (done == 0) { break; }
+            total += uint64_t(done);
+        }
+        bytes += total;
+        return total;
+    }
+
+    public:
+    explicit Edge_File_Reader(const std::string& filename_) : filename(filename_)
+    {
+        descriptor = ::open(filename.c_str(), O_RDONLY);
+        if (descriptor < 0) { throw std::runtime_error("Cannot open " + filename); }
+        ::posix_fadvise(descriptor, 0, 0, POSIX_FADV_SEQUENTIAL);
+        if (read_bytes(&header, sizeof(header)) != sizeof(header) || header.magic != Edge_File_Header::magic_value)
+        {
+            ::close(descriptor);
+            throw std::runtime_error(filename + " is not an edge file");
+        }
+        if (header.version != Edge_File_Header::current_version)
+        {
+            ::close(descriptor);
+            throw std::runtime_error(filename + ": unsupported version " + std::to_string(header.version));
+        }
+        remaining = header.edges;
+    }
+
+    ~Edge_File_Reader() { ::close(descriptor); }
+
+    Edge_File_Reader(const Edge_File_Reader&) = delete;
+    Edge_File_Reader& operator=(const Edge_File_Reader&) = delete;
+
+    const std::string& name() const { return filename; }
+    uint32_t vertex_count() const { return header.vertices; }
+    uint64_t edge_count() const { return header.edges; }
+    uint64_t bytes_read() const { return bytes; }
+
+    // Fills edges with up to count of the next edges, returns how many; 0 at the end of the file.
+    uint64_t read(CSR_Edge* edges, uint64_t count)
+    {
+        count = std::min(count, remaining);
+        if (read_bytes(edges, count * sizeof(CSR_Edge)) != count * sizeof(CSR_Edge)) { throw std::runtime_error(filename + " is truncated"); }
+        remaining -= count;
+        return count;
+    }
+};
+
+inline void write_edge_file(const std::vector<CSR_Edge>& edges, uint32_t vertices, const std::string& filename)
+{
+    Edge_File_Writer writer(filename, vertices);
+    writer.write(edges.data(), edges.size());
+    writer.close();
+}
+
+#endif // GRAPH_IO_HPP
@@ -0,0 +1,231 @@
+#ifndef GRAPH_REORDER_HPP
+#define GRAPH_REORDER_HPP
+
+// Vertex reordering for locality. Ids coming from upstream systems are arbitrary, so the per-vertex arrays of a
+// traversal (distances, stamps, offsets) are hit at random positions and almost every edge costs a cache miss.
+// Renaming vertices so that neighbours get close ids turns those accesses into nearby ones:
+//
+//     grid 3 x 3, random ids        BFS order
+//     7 - 2 - 5                     0 - 1 - 3
+//     |   |   |                     |   |   |
+//     0 - 8 - 3                     2 - 4 - 6
+//     |   |   |                     |   |   |
+//     4 - 6 - 1                     5 - 7 - 8
+//
+// Orders (each returns a Vertex_Order, apply it with reorder()):
+//   degree_order()          - by degree, descending. Hubs share a few cache lines; cheap, helps skewed graphs only.
+//   bfs_order()             - in the order a BFS discovers vertices, every component from its smallest id.
+//   reverse_cuthill_mckee() - BFS from a pseudo-peripheral vertex of every component, neighbours by increasing
+//                             degree, whole sequence reversed. Minimizes the bandwidth max |new(u) - new(v)|; good for
+//                             meshes and road networks.
+//   gorder_lite()           - greedy Gorder: the next id goes to the vertex with the most neighbours and common
+//                             neighbours among the last `window` placed vertices. Common neighbours are counted only
+//                             through vertices of degree <= hub_degree (the cost grows with the squared degree).
+//                             Best for skewed graphs, slowest to compute.
+//
+// All orders look at out-neighbours only; for directed graphs pass the undirected version.
+// Vertex_Order keeps both directions of the renaming, so results computed on the reordered graph (per-vertex values,
+// vertex ids) are translated back to the original ids.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <queue>
+#include <vector>
+#include "bfs.h"
+#include "csr_graph.h"
+#include "traversal_workspace.h"
+
+struct Vertex_Order
+{
+    public:
+    std::vector<uint32_t> new_id; // Indexed by original id.
+    std::vector<uint32_t> old_id; // Indexed by new id.
+
+    // sequence[i] is the original vertex which gets id i.
+    static Vertex_Order from_sequence(std::vector<uint32_t> sequence)
+    {
+        Vertex_Order order;
+        order.new_id.resize(sequence.size());
+        for (uint32_t i = 0; i < sequence.size(); i++) { order.new_id[sequence[i]] = i; }
+        order.old_id = std::move(sequence);
+        return order;
+    }
+
+    static Vertex_Order identity(uint32_t vertices)
+    {
+        std::vector<uint32_t> sequence(vertices);
+        for (uint32_t v = 0; v < vertices; v++) { sequence[v] = v; }
+        return from_sequence(std::move(sequence));
+    }
+
+    uint32_t to_new(uint32_t original) const { return new_id[original]; }
+    uint32_t to_original(uint32_t renamed) const { return old_id[renamed]; }
+
+    // Per-vertex values of the reordered graph, indexed by original id.
+    template <typename T>
+    std::vector<T> to_original(const std::vector<T>& values) const
+    {
+        std::vector<T> result(values.size());
+        for (uint32_t v = 0; v < values.size(); v++) { result[old_id[v]] = values[v]; }
+        return result;
+    }
+
+    // Vertex ids stored as values (parents, paths): renamed back, negative entries (no vertex) stay as they are.
+    template <typename T>
+    std::vector<T> ids_to_original(const std::vector<T>& ids) const
+    {
+        std::vector<T> result(ids.size());
+        for (size_t i = 0; i < ids.size(); i++) { result[i] = ids[i] < 0 ? ids[i] : T(old_id[uint32_t(ids[i])]); }
+        return result;
+    }
+};
+
+inline CSR_Graph reorder(const CSR_Graph& graph, const Vertex_Order& order) { return graph.permuted(order.new_id); }
+
+inline Vertex_Order degree_order(const CSR_Graph& graph)
+{
+    std::vector<uint32_t> sequence(graph.vertex_count());
+    for (uint32_t v = 0; v < graph.vertex_count(); v++) { sequence[v] = v; }
+    std::stable_sort(sequence.begin(), sequence.end(), [&](uint32_t a, uint32_t b) { return graph.degree(a) > graph.degree(b); });
+    return Vertex_Order::from_sequence(std::move(sequence));
+}
+
+inline Vertex_Order bfs_order(const CSR_Graph& graph)
+{
+    std::vector<uint32_t> sequence;
+    sequence.reserve(graph.vertex_count());
+    std::vector<bool> visited(graph.vertex_count(), false);
+    for (uint32_t root = 0; root < graph.vertex_count(); root++)
+    {
+        if (visited[root]) { continue; }
+        visited[root] = true;
+        sequence.push_back(root);
+        for (size_t head = sequence.size() - 1; head < sequence.size(); head++)
+        {
+            for (uint32_t v : graph.neighbours(sequence[head]))
+            {
+                if (!visited[v]) { visited[v] = true; sequence.push_back(v); }
+            }
+        }
+    }
+    return Vertex_Order::from_sequence(std::move(sequence));
+}
+
+// George-Liu: BFS from start, restart from a vertex of minimal degree in the last level while the depth grows.
+inline uint32_t pseudo_peripheral_vertex(const CSR_Graph& graph, uint32_t start, Traversal_Workspace& workspace)
+{
+    unsigned int eccentricity = 0;
+    for (int round = 0; round < 8; round++)
+    {
+        breadth_first_search(graph, start, workspace);
+        const std::vector<uint32_t>& reached = workspace.touched();
+        unsigned int depth = workspace.distance(reached.back());
+        if (round > 0 && depth <= eccentricity) { break; }
+        eccentricity = depth;
+        uint32_t best = reached.back();
+        for (size_t i = reached.size(); i-- > 0 && workspace.distance(reached[i]) == depth;)
+        {
+            if (graph.degree(reached[i]) < graph.degree(best)) { best = reached[i]; }
+        }
+        start = best;
+    }
+    return start;
+}
+
+inline Vertex_Order reverse_cuthill_mckee(const CSR_Graph& graph)
+{
+    uint32_t vertices = graph.vertex_count();
+    std::vector<uint32_t> by_degree(vertices);
+    for (uint32_t v = 0; v < vertices; v++) { by_degree[v] = v; }
+    std::stable_sort(by_degree.begin(), by_degree.end(), [&](uint32_t a, uint32_t b) { return graph.degree(a) < graph.degree(b); });
+
+    std::vector<uint32_t> sequence;
+    sequence.reserve(vertices);
+    std::vector<bool> visited(vertices, false);
+    Traversal_Workspace workspace;
+    for (uint32_t candidate : by_degree)
+    {
+        if (visited[candidate]) { continue; }
+        uint32_t root = pseudo_peripheral_vertex(graph, candidate, workspace);
+        visited[root] = true;
+        sequence.push_back(root);
+        for (size_t head = sequence.size() - 1; head < sequence.size(); head++)
+        {
+            size_t first = sequence.size();
+            for (uint32_t v : graph.neighbours(sequence[head]))
+            {
+                if (!visited[v]) { visited[v] = true; sequence.push_back(v); }
+            }
+            std::stable_sort(sequence.begin() + first, sequence.end(), [&](uint32_t a, uint32_t b) { return graph.degree(a) < graph.degree(b); });
+        }
+    }
+    std::reverse(sequence.begin(), sequence.end());
+    return Vertex_Order::from_sequence(std::move(sequence));
+}
+
+inline Vertex_Order gorder_lite(const CSR_Graph& graph, uint32_t window = 5, uint32_t hub_degree = 32)
+{
+    uint32_t vertices = graph.vertex_count();
+    std::vector<uint32_t> score(vertices, 0), queued(vertices, 0);
+    std::vector<bool> placed(vertices, false);
+    // Key score << 32 | ~v: the highest score first, the smallest id among equal scores. Entries are upper bounds:
+    // a score only grows through a new entry, a stale one is re-queued with the current score when it comes out.
+    std::priority_queue<uint64_t> heap;
+    auto key = [](uint32_t s, uint32_t v) { return uint64_t(s) << 32 | ~v; };
+
+    auto update = [&](uint32_t v, int change) {
+        auto add = [&](uint32_t u) {
+            if (placed[u]) { return; }
+            score[u] += change;
+            if (change > 0 && score[u] > queued[u]) { queued[u] = score[u]; heap.push(key(score[u], u)); }
+        };
+        for (uint32_t u : graph.neighbours(v))
+        {
+            add(u);
+            if (graph.degree(u) > hub_degree) { continue; }
+            for (uint32_t w : graph.neighbours(u)) { if (w != v) { add(w); } }
+        }
+    };
+
+    Vertex_Order by_degree = degree_order(graph);
+    uint32_t next_fallback = 0;
+    std::vector<uint32_t> sequence;
+    sequence.reserve(vertices);
+    while (sequence.size() < vertices)
+    {
+        uint32_t next = UINT32_MAX;
+        while (!heap.empty() && next == UINT32_MAX)
+        {
+            uint32_t v = ~uint32_t(heap.top()), s = uint32_t(heap.top() >> 32);
+            heap.pop();
+            if (placed[v] || s != queued[v]) { continue; }
+            if (score[v] == s) { next = v; }
+            else if (score[v] > 0) { queued[v] = score[v]; heap.push(key(score[v], v)); }
+            else { queued[v] = 0; }
+        }
+        if (next == UINT32_MAX)
+        {
+            while (placed[by_degree.old_id[next_fallback]]) { next_fallback++; }
+            next = by_degree.old_id[next_fallback];
+        }
+        placed[next] = true;
+        sequence.push_back(next);
+        update(next, +1);
+        if (sequence.size() > window) { update(sequence[sequence.size() - window - 1], -1); }
+    }
+    return Vertex_Order::from_sequence(std::move(sequence));
+}
+
+// Locality of an order: the average log2(|u - v| + 1) over all edges (lower is better, about log2 V for random ids).
+inline double average_log_gap(const CSR_Graph& graph)
+{
+    double total = 0;
+    for (uint32_t u = 0; u < graph.vertex_count(); u++)
+    {
+        for (uint32_t v : graph.neighbours(u)) { total += std::log2(double(u > v ? u - v : v - u) + 1); }
+    }
+    return graph.edge_count() ? total / graph.edge_count() : 0;
+}
+
+#endif // GRAPH_REORDER_HPP
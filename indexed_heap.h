@@ -0,0 +1,109 @@
+#ifndef INDEXED_HEAP_HPP
+#define INDEXED_HEAP_HPP
+
+// Binary min_heap over the ids 0..n-1, every id with a key. position[id] says where the id sits in the heap array,
+// so the key of an id already in the heap can be lowered in place instead of inserting a second copy of it:
+//
+//     ids:       [ 4  1  3 ]        keys: 1 -> 7, 3 -> 9, 4 -> 2
+//     position:  1 -> 1, 3 -> 2, 4 -> 0, others absent
+//     push_or_decrease(3, 1)  ->  3 sifts up  ->  [ 3  1  4 ]
+//
+// The heap never holds more than n entries (a lazy heap holds one per relaxed edge), which is what Prim and Dijkstra
+// need on dense graphs. Sifting keeps a hole and writes the moved element once, as binary_heap.h does.
+
+#include <cstdint>
+#include <vector>
+
+template <typename Key>
+class Indexed_Heap
+{
+    private:
+    static constexpr uint32_t ABSENT = UINT32_MAX;
+
+    std::vector<uint32_t> heap;
+    std::vector<uint32_t> position;
+    std::vector<Key> keys;
+
+    void place(uint32_t index, uint32_t id)
+    {
+        heap[index] = id;
+        position[id] = index;
+    }
+
+    void sift_up(uint32_t index)
+    {
+        uint32_t id = heap[index];
+        while (index > 0)
+        {
+            uint32_t parent = (index - 1) / 2;
+            if (!(keys[id] < keys[heap[parent]])) { break; }
+            place(index, heap[parent]);
+            index = parent;
+        }
+        place(index, id);
+    }
+
+    void sift_down(uint32_t index)
+    {
+        uint32_t id = heap[index];
+        uint32_t size = uint32_t(heap.size());
+        while (true)
+        {
+            uint32_t child = 2 * index + 1;
+            if (child >= size) { break; }
+            if (child + 1 < size && keys[heap[child + 1]] < keys[heap[child]]) { child++; }
+            if (!(keys[heap[child]] < keys[id])) { break; }
+            place(index, heap[child]);
+            index = child;
+        }
+        place(index, id);
+    }
+
+    public:
+    explicit Indexed_Heap(uint32_t ids = 0) : position(ids, ABSENT), keys(ids) {}
+
+    bool is_empty() const { return heap.empty(); }
+    uint32_t get_size() const { return uint32_t(heap.size()); }
+    bool contains(uint32_t id) const { return position[id] != ABSENT; }
+    const Key& key(uint32_t id) const { return keys[id]; }
+
+    // Inserts id, or lowers its key if it is in the heap with a greater one. Returns false if nothing changed.
+    bool push_or_decrease(uint32_t id, const Key& key)
+    {
+        if (position[id] == ABSENT)
+        {
+            keys[id] = key;
+            heap.push_back(id);
+            sift_up(uint32_t(heap.size() - 1));
+            return true;
+        }
+        if (!(key < keys[id])) { return false; }
+        keys[id] = key;
+        sift_up(position[id]);
+        return true;
+    }
+
+    uint32_t min_peek() const { return heap.front(); }
+
+    uint32_t extract_peek()
+    {
+        uint32_t id = heap.front();
+        position[id] = ABSENT;
+        uint32_t last = heap.back();
+        heap.pop_back();
+        if (!heap.empty())
+        {
+            heap[0] = last;
+            sift_down(0);
+        }
+        return id;
+    }
+
+    void clear()
+    {
+        for (uint32_t id : heap) { position[id] = ABSENT; }
+        heap.clear();
+    }
+};
+
+#endif // INDEXED_HEAP_HPP
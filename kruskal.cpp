@@ -5,6 +5,9 @@
 #include <vector>
 #include <algorithm>
 #include <cassert>
+#include "csr_graph.h"
+#include "spanning_tree.h"
+#include "thread_pool.h"
 
 struct Edge 
 {
@@ -36,9 +39,16 @@ struct DSU {
     int find_parent(int current_vertex)
     {
         assert(current_vertex >= 0 && current_vertex != parent.size());
-        if (parent[current_vertex] != current_vertex)
-            parent[current_vertex] = find_parent(parent[current_vertex]);
-        return parent[current_vertex];
+        // Two passes instead of recursion: a long chain before the first compression must not overflow the stack.
+        int root = current_vertex;
+        while (parent[root] != root)
+            root = parent[root];
+        while (parent[current_vertex] != root) {
+            int next = parent[current_vertex];
+            parent[current_vertex] = root;
+            current_vertex = next;
+        }
+        return root;
     }
 
     void make_union(int u, int v)
@@ -105,6 +115,39 @@ void kruskal(const std::vector<std::vector<Edge>> &graph) {
     std::cout << "Total weight equals to: " << total_weight << std::endl;
 }
 
+// The same algorithm on the shared CSR representation. Every undirected edge is stored twice, take it once (from <= to).
+void kruskal(const CSR_Graph& graph) {
+
+    std::vector<Edge> all_edges;
+    for (uint32_t u = 0; u < graph.vertex_count(); u++) {
+        for (uint64_t edge = graph.first_edge(u); edge < graph.last_edge(u); edge++) {
+            uint32_t v = graph.target(edge);
+            if (u <= v) { all_edges.emplace_back(Edge(u, v, graph.weight(edge))); }
+        }
+    }
+    std::sort(all_edges.begin(), all_edges.end());
+
+    std::vector<Edge> mst;
+    DSU dsu(graph.vertex_count());
+    int total_weight = 0;
+
+    for (const Edge& edge : all_edges)
+    {
+        if (dsu.find_parent(edge.vertex_from) != dsu.find_parent(edge.vertex_to))
+        {
+            dsu.make_union(edge.vertex_from,edge.vertex_to);
+            total_weight+=edge.weight;
+            mst.emplace_back(edge);
+        }
+    }
+
+    std::cout << "Minimal Spanning Tree using Kruskal's algorithm on CSR graph" << std::endl;
+    for (const auto& edge : mst) {
+        std::cout << edge;
+    }
+    std::cout << "Total weight equals to: " << total_weight << std::endl;
+}
+
 int main()
 {
     std::vector<std::vector<Edge>> graph = 
@@ -119,6 +162,23 @@ int main()
 
     kruskal(graph);
 
+    std::vector<CSR_Edge> edges;
+    for (const auto& vertex : graph) {
+        for (const Edge& edge : vertex) {
+            edges.emplace_back(CSR_Edge(edge.vertex_from, edge.vertex_to, edge.weight));
+        }
+    }
+    kruskal(CSR_Graph::from_edges(graph.size(), edges));
+
+    // Filter-Kruskal works on the flat edge list itself (reordering it), both directions of an edge may stay in it.
+    Thread_Pool pool;
+    Spanning_Forest forest = filter_kruskal(edges, graph.size(), pool);
+    std::cout << "Minimal Spanning Tree using filter-Kruskal" << std::endl;
+    for (const CSR_Edge& edge : forest.edges) {
+        std::cout << edge.vertex_from << " -> " << edge.vertex_to << ". Weight: " << edge.weight << '\n';
+    }
+    std::cout << "Total weight equals to: " << forest.total_weight << std::endl;
+
     return 0;
 }
 
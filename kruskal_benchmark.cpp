@@ -0,0 +1,47 @@
+// Kruskal (sort everything, then scan) against filter-Kruskal from spanning_tree.h on one thread and on the pool,
+// for a dense random graph, where most edges are useless, and for a road-like grid, where almost every edge is needed.
+// Total weights and edge counts of all spanning forests must be equal.
+// Usage: ./kruskal_benchmark [vertices] [edges] [grid_side]
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include "csr_graph.h"
+#include "graph_generators.h"
+#include "spanning_tree.h"
+#include "thread_pool.h"
+#include "timing.h"
+
+void run(const char* name, const std::vector<CSR_Edge>& input, uint32_t vertices, Thread_Pool& pool)
+{
+    std::cout << name << "\tvertices: " << vertices << "\tedges: " << input.size() << std::endl;
+    std::vector<CSR_Edge> edges = input;
+    Spanning_Forest expected;
+    double seconds = measure([&]() { expected = sorting_kruskal(std::move(edges), vertices); });
+    std::cout << "  Sort + scan:\t\t" << seconds << " s\ttree edges: " << expected.edges.size() << "\tweight: " << expected.total_weight << std::endl;
+
+    Thread_Pool single(1);
+    for (Thread_Pool* threads : {&single, &pool})
+    {
+        edges = input;
+        Spanning_Forest forest;
+        seconds = measure([&]() { forest = filter_kruskal(edges, vertices, *threads); });
+        bool correct = forest.total_weight == expected.total_weight && forest.edges.size() == expected.edges.size();
+        std::cout << "  Filter-Kruskal, " << threads->size() << " threads:\t" << seconds << " s" << (correct ? "" : "\tMISMATCH") << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t vertices = argc > 1 ? std::atoi(argv[1]) : 100000;
+    uint64_t edge_count = argc > 2 ? std::atoll(argv[2]) : 10000000;
+    uint32_t side = argc > 3 ? std::atoi(argv[3]) : 1000;
+
+    Thread_Pool pool;
+    run("Random", generate_edges(Erdos_Renyi_Generator(vertices, edge_count, 42, 1000000), pool), vertices, pool);
+    run("Grid", generate_edges(Grid_Generator(side, side, 42, 1000000), pool), side * side, pool);
+
+    return 0;
+}
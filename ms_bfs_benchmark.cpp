@@ -0,0 +1,62 @@
+// Benchmark of batched reachability queries: one breadth-first search per query versus multi-source BFS
+// with 64 (one word) and 256 (four words) sources per traversal. Distances are checked against the single-source BFS.
+// Usage: ./ms_bfs_benchmark [vertices] [undirected_edges] [queries]
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cstdlib>
+#include "csr_graph.h"
+#include "bfs.h"
+#include "graph_generators.h"
+#include "thread_pool.h"
+#include "timing.h"
+
+int main(int argc, char* argv[])
+{
+    uint32_t vertices = argc > 1 ? std::atoi(argv[1]) : 100000;
+    uint64_t edge_count = argc > 2 ? std::atoll(argv[2]) : 800000;
+    int queries = argc > 3 ? std::atoi(argv[3]) : 256;
+
+    CSR_Graph graph;
+    {
+        Thread_Pool pool;
+        graph = generate_graph(Erdos_Renyi_Generator(vertices, edge_count, 42), pool, true, false);
+    }
+    std::mt19937 rng(42);
+
+    std::vector<uint32_t> sources(queries);
+    for (auto& source : sources) { source = rng() % vertices; }
+    std::cout << "Vertices: " << vertices << "\tDirected edges: " << graph.edge_count() << "\tQueries: " << queries << std::endl;
+
+    std::vector<std::vector<int>> expected(queries);
+    double seconds = measure([&]() {
+        for (int i = 0; i < queries; i++) { expected[i] = top_down_bfs(graph, sources[i]).depths; }
+    });
+    std::cout << "One BFS per query:\t" << seconds << " s\t" << queries / seconds << " queries/s" << std::endl;
+
+    std::vector<std::vector<int>> distances;
+    seconds = measure([&]() { distances = multi_source_bfs<1>(graph, sources); });
+    std::cout << "MS-BFS, 64 per batch:\t" << seconds << " s\t" << queries / seconds << " queries/s"
+              << (distances == expected ? "" : "\tMISMATCH") << std::endl;
+
+    seconds = measure([&]() { distances = multi_source_bfs<4>(graph, sources); });
+    std::cout << "MS-BFS, 256 per batch:\t" << seconds << " s\t" << queries / seconds << " queries/s"
+              << (distances == expected ? "" : "\tMISMATCH") << std::endl;
+
+    std::vector<std::vector<uint32_t>> neighbourhoods;
+    seconds = measure([&]() { neighbourhoods = multi_source_neighbourhoods<4>(graph, sources, 2); });
+    uint64_t total = 0;
+    bool correct = true;
+    for (int i = 0; i < queries; i++)
+    {
+        uint64_t within = 0;
+        for (int depth : expected[i]) { within += depth >= 0 && depth <= 2; }
+        correct &= within == neighbourhoods[i].size();
+        total += neighbourhoods[i].size();
+    }
+    std::cout << "2-hop neighbourhoods:\t" << seconds << " s\taverage size " << total / double(queries)
+              << (correct ? "" : "\tMISMATCH") << std::endl;
+
+    return 0;
+}
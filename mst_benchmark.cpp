@@ -0,0 +1,68 @@
+// Every MST engine of spanning_tree.h on graphs of very different density: a complete "similarity" graph, a dense random
+// graph, a sparse random graph with many components, and a road-like grid. Times of dense Prim (on a ready matrix and
+// converted from CSR), sparse Prim, filter-Kruskal and Boruvka, then the choice of minimum_spanning_forest().
+// Total weight and the number of forest edges must match Kruskal (sort + scan) for all of them.
+// Usage: ./mst_benchmark [complete_vertices] [grid_side]
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include "csr_graph.h"
+#include "graph_generators.h"
+#include "spanning_tree.h"
+#include "thread_pool.h"
+#include "timing.h"
+
+void run(const char* name, const CSR_Graph& graph, Thread_Pool& pool)
+{
+    std::cout << name << "\tvertices: " << graph.vertex_count() << "\tedges: " << graph.edge_count() / 2 << std::endl;
+    Spanning_Forest expected = sorting_kruskal(undirected_edge_list(graph), graph.vertex_count());
+    std::cout << "  trees: " << graph.vertex_count() - expected.edges.size() << "\tweight: " << expected.total_weight << std::endl;
+
+    if (uint64_t(graph.vertex_count()) * graph.vertex_count() <= (1ull << 28))
+    {
+        // Similarity graphs usually arrive as a matrix; then dense Prim has nothing to convert.
+        Weight_Matrix matrix = Weight_Matrix::from_graph(graph);
+        Spanning_Forest forest;
+        double seconds = measure([&]() { forest = minimum_spanning_forest(matrix); });
+        bool correct = forest.total_weight == expected.total_weight && forest.edges.size() == expected.edges.size();
+        std::cout << "  Prim, dense, matrix input:\t" << seconds << " s" << (correct ? "" : "\tMISMATCH") << std::endl;
+    }
+    for (MST_Algorithm algorithm : {MST_Algorithm::prim_dense, MST_Algorithm::prim_sparse, MST_Algorithm::kruskal,
+                                    MST_Algorithm::boruvka, MST_Algorithm::automatic})
+    {
+        if (algorithm == MST_Algorithm::prim_dense && uint64_t(graph.vertex_count()) * graph.vertex_count() > (1ull << 28)) { continue; }
+        Spanning_Forest forest;
+        double seconds = measure([&]() { forest = minimum_spanning_forest(graph, pool, algorithm); });
+        bool correct = forest.total_weight == expected.total_weight && forest.edges.size() == expected.edges.size();
+        std::cout << "  " << mst_algorithm_name(algorithm);
+        if (algorithm == MST_Algorithm::automatic)
+        {
+            std::cout << " (" << mst_algorithm_name(choose_mst_algorithm(graph.vertex_count(), graph.edge_count(), pool.size())) << ")";
+        }
+        std::cout << ":\t" << seconds << " s" << (correct ? "" : "\tMISMATCH") << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t complete = argc > 1 ? std::atoi(argv[1]) : 3000;
+    uint32_t side = argc > 2 ? std::atoi(argv[2]) : 1000;
+
+    Thread_Pool pool;
+    std::vector<CSR_Edge> edges;
+    for (uint32_t u = 0; u < complete; u++)
+    {
+        for (uint32_t v = u + 1; v < complete; v++) { edges.emplace_back(u, v, Edge_Random(42, uint64_t(u) * complete + v).weight(1000000)); }
+    }
+    run("Complete", CSR_Graph::from_edges(complete, edges, true), pool);
+    std::vector<CSR_Edge>().swap(edges);
+
+    run("Dense random, 30%", generate_graph(Erdos_Renyi_Generator(4000, 2400000, 42, 1000000), pool, true), pool);
+    run("Random, average degree 32", generate_graph(Erdos_Renyi_Generator(200000, 3200000, 42, 1000000), pool, true), pool);
+    run("Random, many components", generate_graph(Erdos_Renyi_Generator(1000000, 400000, 42, 1000000), pool, true), pool);
+    run("Grid", generate_graph(Grid_Generator(side, side, 42, 1000000), pool, true), pool);
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+// Quality versus throughput benchmark for Multi_Queue.
+// Every thread inserts its share of keys 0..N-1 (random permutation), after that every thread extracts until the queue is empty.
+// Throughput: million operations per second. Quality: rank error of every extracted key, i.e. how many smaller keys
+// were still inside the queue at the moment of extraction (0 for an exact priority queue).
+// Usage: ./multi_queue [number_of_keys]
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include "multi_queue.h"
+
+// Fenwick tree over keys which are still inside the queue. It answers "how many keys smaller than x are present".
+struct Fenwick_Tree
+{
+    std::vector<int> tree;
+    Fenwick_Tree(int n) : tree(n + 1, 0) {}
+    void add(int index, int delta) { for (++index; index < (int)tree.size(); index += index & -index) tree[index] += delta; }
+    int prefix(int index) const { int sum = 0; for (; index > 0; index -= index & -index) sum += tree[index]; return sum; }
+};
+
+void run(int keys, int threads, int c)
+{
+    std::vector<int> permutation(keys);
+    for (int i = 0; i < keys; i++) { permutation[i] = i; }
+    std::shuffle(permutation.begin(), permutation.end(), std::mt19937(42));
+
+    Multi_Queue<int> queue(threads, c);
+    std::vector<int> extracted(keys);
+    std::atomic<int> sequence(0);
+    std::atomic<int> inserted_threads(0);
+
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++)
+    {
+        workers.emplace_back([&, t]() {
+            for (int i = t; i < keys; i += threads) { queue.insert(permutation[i]); }
+            inserted_threads++;
+            while (inserted_threads.load() < threads) { std::this_thread::yield(); } // Barrier between phases.
+            int key;
+            while (queue.try_extract(key)) { extracted[sequence++] = key; }
+        });
+    }
+    for (auto& worker : workers) { worker.join(); }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    // Extraction order is approximated by the order of sequence numbers.
+    Fenwick_Tree present(keys);
+    for (int i = 0; i < keys; i++) { present.add(i, 1); }
+    long long total_error = 0;
+    int max_error = 0;
+    for (int i = 0; i < keys; i++)
+    {
+        int rank = present.prefix(extracted[i]);
+        total_error += rank;
+        max_error = std::max(max_error, rank);
+        present.add(extracted[i], -1);
+    }
+
+    std::cout << "threads: " << threads << "\tc: " << c
+              << "\tMops/s: " << 2.0 * keys / seconds / 1e6
+              << "\tmean rank error: " << (double)total_error / keys
+              << "\tmax rank error: " << max_error << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    int keys = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int c : {1, 2, 4})
+    {
+        for (int threads = 1; threads <= max_threads; threads *= 2)
+        {
+            run(keys, threads, c);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+#ifndef MULTI_QUEUE_HPP
+#define MULTI_QUEUE_HPP
+
+// MultiQueue is a relaxed concurrent priority queue. It consists of c * T ordinary sequential heaps (T = number of threads),
+// every heap is protected by its own lock.
+// insert(): pick a random heap. If somebody holds its lock - pick another one instead of waiting.
+// try_extract(): pick two random heaps, lock both and pop the smaller of their tops.
+//
+//     thread 1  ---insert--->  [heap 0]  [heap 1]  [heap 2]  [heap 3]  ...  [heap c*T-1]
+//     thread 2  <--extract---  min(top of heap 1, top of heap 3)
+//
+// Extracted element is not always the global minimum, but its rank (how many smaller elements are still inside)
+// stays O(c * T) on average. In exchange threads almost never wait for each other, so throughput scales with cores.
+// Algorithms which tolerate such relaxation (label-correcting shortest paths, Prim with re-checks) use it directly.
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "priority_queue.h"
+
+template <typename T>
+class Multi_Queue {
+private:
+    struct Sub_Queue {
+        std::mutex lock;
+        Priority_Queue<T> heap;
+    };
+
+    std::vector<std::unique_ptr<Sub_Queue>> queues;
+    std::atomic<long long> size;
+
+    static std::minstd_rand& generator()
+    {
+        thread_local std::minstd_rand rng(static_cast<unsigned>(std::hash<std::thread::id>{}(std::this_thread::get_id())));
+        return rng;
+    }
+
+    int random_queue() { return static_cast<int>(generator()() % queues.size()); }
+
+    // Fallback for the case when both sampled heaps are empty: walk over every heap once.
+    bool extract_from_any(T& element)
+    {
+        int start = random_queue();
+        for (size_t i = 0; i < queues.size(); i++)
+        {
+            Sub_Queue& queue = *queues[(start + i) % queues.size()];
+            std::lock_guard<std::mutex> guard(queue.lock);
+            if (!queue.heap.is_empty())
+            {
+                element = queue.heap.min_peek();
+                queue.heap.extract_peek();
+                size--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    // threads - how many threads are going to share the queue, c - how many heaps per thread.
+    Multi_Queue(int threads, int c = 2) : size(0)
+    {
+        int count = std::max(2, threads * c);
+        for (int i = 0; i < count; i++)
+        {
+            queues.emplace_back(new Sub_Queue);
+        }
+    }
+
+    void insert(const T& element)
+    {
+        while (true)
+        {
+            Sub_Queue& queue = *queues[random_queue()];
+            if (queue.lock.try_lock())
+            {
+                queue.heap.insert(element);
+                size++;
+                queue.lock.unlock();
+                return;
+            }
+        }
+    }
+
+    // Returns false only when the whole queue has been seen empty.
+    bool try_extract(T& element)
+    {
+        while (size.load(std::memory_order_relaxed) > 0)
+        {
+            int first = random_queue();
+            int second = random_queue();
+            if (first == second) { continue; }
+
+            Sub_Queue& a = *queues[first];
+            Sub_Queue& b = *queues[second];
+            if (!a.lock.try_lock()) { continue; }
+            if (!b.lock.try_lock()) { a.lock.unlock(); continue; }
+
+            Sub_Queue* best = nullptr;
+            if (!a.heap.is_empty()) { best = &a; }
+            if (!b.heap.is_empty() && (best == nullptr || b.heap.min_peek() < a.heap.min_peek())) { best = &b; }
+
+            if (best != nullptr)
+            {
+                element = best->heap.min_peek();
+                best->heap.extract_peek();
+                size--;
+            }
+            b.lock.unlock();
+            a.lock.unlock();
+
+            if (best != nullptr) { return true; }
+            return extract_from_any(element);
+        }
+        return false;
+    }
+
+    long long get_size() const { return size.load(); }
+
+    bool is_empty() const { return size.load() == 0; }
+};
+
+#endif // MULTI_QUEUE_HPP
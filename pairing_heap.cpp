@@ -0,0 +1,37 @@
+// Demonstration of Pairing_Heap: two frontiers are built independently and then combined with a single meld().
+// With Priority_Queue the same combination requires popping one heap into another element by element: O(n log n).
+
+#include <iostream>
+#include "pairing_heap.h"
+
+int main()
+{
+    Pairing_Heap<int> first_frontier;
+    Pairing_Heap<int> second_frontier;
+
+    first_frontier.insert(40);
+    first_frontier.insert(12);
+    Pairing_Heap<int>::Handle handle = first_frontier.insert(90);
+
+    second_frontier.insert(30);
+    second_frontier.insert(18);
+    second_frontier.insert(21);
+
+    first_frontier.meld(second_frontier); // O(1). Second frontier is empty now.
+
+    // Handle still points to 90, which now lives in the melded heap.
+    first_frontier.decrease_key(handle, 5);
+
+    std::cout << "Size after meld:\t" << first_frontier.get_size() << std::endl;
+    std::cout << "Extract in order:\t";
+    while (!first_frontier.is_empty())
+    {
+        std::cout << first_frontier.min_peek() << '\t';
+        first_frontier.extract_peek();
+    }
+    std::cout << std::endl;
+
+    // Output: 5 12 18 21 30 40
+
+    return 0;
+}
@@ -0,0 +1,226 @@
+#ifndef PAIRING_HEAP_HPP
+#define PAIRING_HEAP_HPP
+
+// Pairing heap is a heap-ordered multiway tree. Every node keeps a pointer to its leftmost child and to its right sibling.
+// It is a mergeable heap: two heaps are melded by comparing their roots and hanging the loser under the winner.
+// insert(), meld() and decrease_key() take O(1), extract_peek() takes O(log n) amortized (two-pass pairing).
+//
+//        2                      2                         2
+//      /            meld       / \                      / | \    (children are linked left to right)
+//     5 - 7     +    3   ->   3 - 5 - 7   insert(4) -> 4  3 - 5 - 7
+//     |              |        |   |                       |   |
+//     9              8        8   9                       8   9
+//
+// Nodes come from a pool of fixed-size blocks, so a handle (pointer to a node) stays valid until its element is extracted,
+// even after the heap it lives in has been melded into another one. Freed nodes are reused by the next insert().
+// Interface is the same as Priority_Queue, so algorithms can select either of them at compile time.
+
+#include <iostream>
+#include <stdexcept>
+
+template <typename T>
+class Pairing_Heap {
+private:
+    struct Node {
+        T value;
+        Node* child = nullptr;   // Leftmost child.
+        Node* sibling = nullptr; // Right sibling. Reused as a link inside the free list.
+        Node* prev = nullptr;    // Parent for the leftmost child, left sibling for the others.
+    };
+
+    static constexpr int block_size = 256;
+
+    struct Block {
+        Node nodes[block_size];
+        Block* next = nullptr;
+    };
+
+    Node* root;
+    int size;
+
+    Block* blocks_head;
+    Block* blocks_tail;
+    int used_in_tail; // How many nodes of the last block have been handed out.
+
+    Node* free_head;
+    Node* free_tail;
+
+    Node* allocate_node(const T& element)
+    {
+        Node* node = nullptr;
+        if (free_head != nullptr) {
+            node = free_head;
+            free_head = free_head->sibling;
+            if (free_head == nullptr) { free_tail = nullptr; }
+        } else {
+            if (blocks_tail == nullptr || used_in_tail == block_size) {
+                Block* block = new Block;
+                if (blocks_tail == nullptr) { blocks_head = block; } else { blocks_tail->next = block; }
+                blocks_tail = block;
+                used_in_tail = 0;
+            }
+            node = &blocks_tail->nodes[used_in_tail++];
+        }
+        node->value = element;
+        node->child = node->sibling = node->prev = nullptr;
+        return node;
+    }
+
+    void release_node(Node* node)
+    {
+        node->child = node->prev = nullptr;
+        node->sibling = nullptr;
+        if (free_tail == nullptr) { free_head = node; } else { free_tail->sibling = node; }
+        free_tail = node;
+    }
+
+    // Both arguments are roots without siblings. The bigger root becomes the leftmost child of the smaller one.
+    Node* link(Node* first, Node* second)
+    {
+        if (first == nullptr) { return second; }
+        if (second == nullptr) { return first; }
+        if (second->value < first->value) { std::swap(first, second); }
+
+        second->sibling = first->child;
+        if (first->child != nullptr) { first->child->prev = second; }
+        second->prev = first;
+        first->child = second;
+        return first;
+    }
+
+    // Two-pass pairing: link children pairwise from left to right, then link the pairs from right to left.
+    // First pass stacks the pairs through the sibling pointer, hence the second pass just walks that stack.
+    Node* merge_pairs(Node* first)
+    {
+        Node* pairs = nullptr;
+        while (first != nullptr) {
+            Node* a = first;
+            Node* b = a->sibling;
+            a->prev = nullptr;
+            if (b == nullptr) {
+                a->sibling = pairs;
+                pairs = a;
+                break;
+            }
+            first = b->sibling;
+            a->sibling = b->sibling = b->prev = nullptr;
+            Node* linked = link(a, b);
+            linked->sibling = pairs;
+            pairs = linked;
+        }
+
+        Node* result = nullptr;
+        while (pairs != nullptr) {
+            Node* next = pairs->sibling;
+            pairs->sibling = nullptr;
+            result = link(result, pairs);
+            pairs = next;
+        }
+        return result;
+    }
+
+public:
+    using Handle = Node*;
+
+    Pairing_Heap() : root(nullptr), size(0), blocks_head(nullptr), blocks_tail(nullptr), used_in_tail(0),
+                     free_head(nullptr), free_tail(nullptr) {}
+
+    // Kept for compatibility with Priority_Queue(capacity). Pool grows on demand, so capacity is only a hint.
+    Pairing_Heap(size_t) : Pairing_Heap() {}
+
+    Pairing_Heap(const Pairing_Heap&) = delete;
+    Pairing_Heap& operator=(const Pairing_Heap&) = delete;
+
+    ~Pairing_Heap()
+    {
+        while (blocks_head != nullptr) {
+            Block* next = blocks_head->next;
+            delete blocks_head;
+            blocks_head = next;
+        }
+    }
+
+    Handle insert(const T& element)
+    {
+        Node* node = allocate_node(element);
+        root = link(root, node);
+        size++;
+        return node;
+    }
+
+    T min_peek() const {
+        if (size == 0) {
+            throw std::out_of_range("Heap is empty");
+        }
+        return root->value;
+    }
+
+    void extract_peek() {
+        if (size == 0) {
+            throw std::out_of_range("Heap is empty");
+        }
+        Node* old_root = root;
+        root = merge_pairs(old_root->child);
+        release_node(old_root);
+        size--;
+    }
+
+    // Cut the subtree of the node out of its parent and link it back with the root.
+    void decrease_key(Handle handle, const T& element)
+    {
+        if (handle->value < element) {
+            throw std::invalid_argument("New key is greater than the current one");
+        }
+        handle->value = element;
+        if (handle == root) { return; }
+
+        if (handle->prev->child == handle) { handle->prev->child = handle->sibling; }
+        else { handle->prev->sibling = handle->sibling; }
+        if (handle->sibling != nullptr) { handle->sibling->prev = handle->prev; }
+        handle->sibling = handle->prev = nullptr;
+
+        root = link(root, handle);
+    }
+
+    // Steal every element of other. Its blocks and free nodes move over as well, therefore handles obtained from
+    // other stay valid and now refer to elements of this heap. other is left empty.
+    void meld(Pairing_Heap& other)
+    {
+        if (this == &other) { return; }
+
+        root = link(root, other.root);
+        size += other.size;
+
+        // Splice the blocks of other in front of ours: our tail block keeps serving fresh nodes.
+        if (other.blocks_head != nullptr) {
+            if (blocks_head == nullptr) {
+                blocks_tail = other.blocks_tail;
+                used_in_tail = other.used_in_tail;
+                blocks_head = other.blocks_head;
+            } else {
+                other.blocks_tail->next = blocks_head;
+                blocks_head = other.blocks_head;
+            }
+        }
+
+        // Never handed out nodes of other's last block stay unused. It is a bounded waste per meld which keeps meld O(1).
+        if (other.free_head != nullptr) {
+            if (free_tail == nullptr) { free_head = other.free_head; } else { free_tail->sibling = other.free_head; }
+            free_tail = other.free_tail;
+        }
+
+        other.root = nullptr;
+        other.size = 0;
+        other.blocks_head = other.blocks_tail = nullptr;
+        other.used_in_tail = 0;
+        other.free_head = other.free_tail = nullptr;
+    }
+
+    const T& value(Handle handle) const { return handle->value; }
+
+    int get_size() const { return size; }
+
+    bool is_empty() const { return size == 0; }
+};
+
+#endif // PAIRING_HEAP_HPP
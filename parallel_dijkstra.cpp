@@ -0,0 +1,195 @@
+// Parallel Dijkstra driven by Multi_Queue.
+// Several threads share one relaxed priority queue. Every thread extracts a (distance, vertex) pair and relaxes outgoing edges.
+// Because the queue is relaxed, a vertex can be extracted before its final distance is known. It is simply relaxed again
+// when a shorter distance arrives later (label-correcting), hence the final distances are exactly the same as in dijkstra().
+// Distance and parent of a vertex are packed into one 64-bit word and updated with a single compare-and-swap,
+// so they never disagree with each other.
+// Usage: ./parallel_dijkstra [vertices] [edges]
+
+#include <iostream>
+#include <vector>
+#include <limits>
+#include <stack>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include "priority_queue.h"
+#include "multi_queue.h"
+
+constexpr unsigned int INF = std::numeric_limits<unsigned int>::max();
+
+struct Edge {
+    public:
+    int vertex_destination;
+    int weight;
+    Edge(int vrtx_d, int weight_) : vertex_destination(vrtx_d), weight(weight_) {}
+};
+
+struct Queue_Entry {
+    public:
+    unsigned int distance;
+    int vertex_id;
+    Queue_Entry() : distance(INF), vertex_id(-1) {}
+    Queue_Entry(unsigned int distance_, int vrtx_id) : distance(distance_), vertex_id(vrtx_id) {}
+    bool operator<(const Queue_Entry& other) const { return this->distance < other.distance; }
+};
+
+using Graph = std::vector<std::vector<Edge>>;
+
+// Label is distance in the upper 32 bits and parent in the lower 32 bits.
+inline uint64_t make_label(unsigned int distance, int parent) { return (uint64_t(distance) << 32) | uint32_t(parent); }
+inline unsigned int label_distance(uint64_t label) { return unsigned(label >> 32); }
+inline int label_parent(uint64_t label) { return int(uint32_t(label)); }
+
+void parallel_dijkstra(const Graph& graph, int start, int threads,
+                       std::vector<unsigned int>& distances, std::vector<int>& parents)
+{
+    std::vector<std::atomic<uint64_t>> labels(graph.size());
+    for (auto& label : labels) { label.store(make_label(INF, -1), std::memory_order_relaxed); }
+    labels[start].store(make_label(0, -1));
+
+    Multi_Queue<Queue_Entry> queue(threads);
+    std::atomic<long long> pending(1); // Entries inside the queue plus entries being processed right now.
+    queue.insert(Queue_Entry{0, start});
+
+    auto worker = [&]() {
+        Queue_Entry current;
+        while (pending.load() > 0)
+        {
+            if (!queue.try_extract(current)) { std::this_thread::yield(); continue; }
+
+            int u = current.vertex_id;
+            if (current.distance <= label_distance(labels[u].load(std::memory_order_relaxed)))
+            {
+                for (const Edge& edge : graph[u])
+                {
+                    int v = edge.vertex_destination;
+                    unsigned int candidate = current.distance + edge.weight;
+                    uint64_t old_label = labels[v].load(std::memory_order_relaxed);
+                    while (candidate < label_distance(old_label))
+                    {
+                        if (labels[v].compare_exchange_weak(old_label, make_label(candidate, u)))
+                        {
+                            pending++;
+                            queue.insert(Queue_Entry{candidate, v});
+                            break;
+                        }
+                    }
+                }
+            }
+            pending--;
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) { workers.emplace_back(worker); }
+    for (auto& thread : workers) { thread.join(); }
+
+    distances.assign(graph.size(), INF);
+    parents.assign(graph.size(), -1);
+    for (size_t i = 0; i < graph.size(); i++)
+    {
+        distances[i] = label_distance(labels[i].load());
+        parents[i] = label_parent(labels[i].load());
+    }
+}
+
+// Sequential reference, the same algorithm as dijkstra() in dijkstra.cpp.
+void dijkstra(const Graph& graph, int start, std::vector<unsigned int>& distances, std::vector<int>& parents)
+{
+    distances.assign(graph.size(), INF);
+    parents.assign(graph.size(), -1);
+    distances[start] = 0;
+
+    Priority_Queue<Queue_Entry> min_heap;
+    min_heap.insert(Queue_Entry{0, start});
+
+    while (!min_heap.is_empty())
+    {
+        Queue_Entry current = min_heap.min_peek();
+        min_heap.extract_peek();
+
+        int u = current.vertex_id;
+        if (current.distance > distances[u]) { continue; }
+
+        for (const auto& edge : graph[u])
+        {
+            int v = edge.vertex_destination;
+            if (distances[u] + edge.weight < distances[v])
+            {
+                distances[v] = distances[u] + edge.weight;
+                parents[v] = u;
+                min_heap.insert(Queue_Entry{distances[v], v});
+            }
+        }
+    }
+}
+
+Graph random_graph(int vertices, long long edges, unsigned seed)
+{
+    Graph graph(vertices);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> vertex(0, vertices - 1);
+    std::uniform_int_distribution<int> weight(1, 100);
+    for (long long i = 0; i < edges; i++)
+    {
+        graph[vertex(rng)].emplace_back(Edge{vertex(rng), weight(rng)});
+    }
+    return graph;
+}
+
+int main(int argc, char* argv[])
+{
+    // The graph from dijkstra.cpp.
+    Graph example(5);
+    example[0] = {Edge{1, 10}, Edge{3, 30}, Edge{4, 100}};
+    example[1] = {Edge{2, 50}};
+    example[2] = {Edge{4, 10}};
+    example[3] = {Edge{2, 20}, Edge{4, 60}};
+
+    std::vector<unsigned int> distances;
+    std::vector<int> parents;
+    parallel_dijkstra(example, 0, 2, distances, parents);
+
+    std::cout << "Distances from vertex 0:\n";
+    for (size_t i = 0; i < distances.size(); i++)
+    {
+        std::cout << "To vertex " << i << ": " << ((distances[i] == INF) ? "INF" : std::to_string(distances[i])) << std::endl;
+    }
+    std::stack<int> order;
+    for (int i = 4; i != -1; i = parents[i]) { order.push(i); }
+    while (!order.empty())
+    {
+        std::cout << order.top();
+        order.pop();
+        if (!order.empty()) std::cout << " -> ";
+    }
+    std::cout << std::endl;
+
+    // Benchmark on a random graph, checked against the sequential version.
+    int vertices = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    long long edges = argc > 2 ? std::atoll(argv[2]) : 8000000;
+    Graph graph = random_graph(vertices, edges, 7);
+
+    std::vector<unsigned int> expected;
+    std::vector<int> expected_parents;
+    auto begin = std::chrono::steady_clock::now();
+    dijkstra(graph, 0, expected, expected_parents);
+    double sequential = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << "\nSequential dijkstra:\t" << sequential << " s" << std::endl;
+
+    int max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int threads = 1; threads <= max_threads; threads *= 2)
+    {
+        begin = std::chrono::steady_clock::now();
+        parallel_dijkstra(graph, 0, threads, distances, parents);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        std::cout << "Parallel dijkstra, threads: " << threads << "\t" << seconds << " s\t"
+                  << (distances == expected ? "distances match" : "MISMATCH") << std::endl;
+    }
+
+    return 0;
+}
@@ -1,6 +1,18 @@
 #include <iostream>
 #include <vector>
 #include "priority_queue.h"
+#include "pairing_heap.h"
+#include "csr_graph.h"
+#include "spanning_tree.h"
+#include "thread_pool.h"
+#include "traversal_workspace.h"
+
+// Build with -DUSE_PAIRING_HEAP to run the algorithm on Pairing_Heap instead of the binary Priority_Queue.
+#ifdef USE_PAIRING_HEAP
+template <typename T> using Min_Heap = Pairing_Heap<T>;
+#else
+template <typename T> using Min_Heap = Priority_Queue<T>;
+#endif
 
 struct Edge
 {
@@ -49,6 +61,7 @@ struct Graph
 
     void build_graph();
     void show_graph() const;
+    std::vector<CSR_Edge> edge_list() const;
 };
 
 // Hence Prim/Kraskal algorithms are dedicated for computing min spanning tree in undirected graph
@@ -88,6 +101,19 @@ void Graph::show_graph() const
     }
 }
 
+std::vector<CSR_Edge> Graph::edge_list() const
+{
+    std::vector<CSR_Edge> edges;
+    for (const auto& vertex : adjacency_table)
+    {
+        for (const auto& edge : vertex.neighbours)
+        {
+            edges.emplace_back(CSR_Edge(edge.vertex_from, edge.vertex_to, edge.weight));
+        }
+    }
+    return edges;
+}
+
 // Struct below is devoted to Edges that will be stored inside Min_Heap. Better do segregation between Edge and HeapEdge.
 // They denote diverse properties.
 struct HeapEdge
@@ -110,7 +136,7 @@ void min_spanning_tree(const Graph& graph)
     long long total_min = 0;
     isVisited[starting_vertex] = true;
 
-    Priority_Queue<HeapEdge> min_heap;
+    Min_Heap<HeapEdge> min_heap;
     for (const auto& neighbour : graph.adjacency_table[starting_vertex].neighbours)
     {
         min_heap.insert(HeapEdge{neighbour.vertex_from,neighbour.vertex_to,neighbour.weight});
@@ -144,6 +170,50 @@ void min_spanning_tree(const Graph& graph)
     std::cout << "Total weight: " << total_min << std::endl;
 }
 
+// The same lazy Prim on the shared CSR representation. Graph already stores both directions of every edge.
+// Visited marks live in a reusable workspace: no O(V) clearing when the tree of a small component is built.
+void min_spanning_tree(const CSR_Graph& graph, int starting_vertex, Traversal_Workspace& workspace)
+{
+    workspace.begin(graph.vertex_count());
+    std::vector<Edge> mst;
+    long long total_min = 0;
+    workspace.visit(starting_vertex);
+
+    Min_Heap<HeapEdge> min_heap;
+    for (uint64_t edge = graph.first_edge(starting_vertex); edge < graph.last_edge(starting_vertex); ++edge)
+    {
+        min_heap.insert(HeapEdge{starting_vertex,int(graph.target(edge)),graph.weight(edge)});
+    }
+
+    while (!min_heap.is_empty())
+    {
+        HeapEdge min_edge = min_heap.min_peek();
+        min_heap.extract_peek();
+
+        int u = min_edge.vertex_from;
+        int v = min_edge.vertex_to;
+        int weight = min_edge.weight;
+
+        if (workspace.is_visited(v)) { continue; }
+
+        workspace.visit(v);
+        workspace.set_parent(v,u);
+        mst.emplace_back(Edge{u,v,weight});
+        total_min += weight;
+
+        for (uint64_t edge = graph.first_edge(v); edge < graph.last_edge(v); ++edge)
+        {
+            min_heap.insert(HeapEdge{v,int(graph.target(edge)),graph.weight(edge)});
+        }
+    }
+
+    std::cout << "Minimum Spanning Tree (Prim's Algorithm on CSR graph):\n";
+    for (const auto& edge : mst) {
+        std::cout << edge;
+    }
+    std::cout << "Total weight: " << total_min << std::endl;
+}
+
 int main()
 {
     Graph g(6);
@@ -153,5 +223,22 @@ int main()
 
     min_spanning_tree(g);
 
+    CSR_Graph csr = CSR_Graph::from_edges(g.V, g.edge_list());
+    Traversal_Workspace workspace;
+    min_spanning_tree(csr, 5, workspace);
+
+    // min_spanning_tree() covers only the component of the starting vertex. Two more vertices joined only to each other:
+    // minimum_spanning_forest() returns a tree for every component. edge_list() already has both directions of every edge.
+    std::vector<CSR_Edge> edges = g.edge_list();
+    edges.emplace_back(CSR_Edge(6, 7, 9));
+    edges.emplace_back(CSR_Edge(7, 6, 9));
+    Thread_Pool pool;
+    Spanning_Forest forest = minimum_spanning_forest(CSR_Graph::from_edges(8, edges), pool);
+    std::cout << "Minimum Spanning Forest (" << 8 - forest.edges.size() << " trees):\n";
+    for (const CSR_Edge& edge : forest.edges) {
+        std::cout << edge.vertex_from << " -> " << edge.vertex_to << ". Edge's weight equals to: " << edge.weight << "\n";
+    }
+    std::cout << "Total weight: " << forest.total_weight << std::endl;
+
     return 0;
 }
\ No newline at end of file
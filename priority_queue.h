@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <climits>
+#include <stdexcept>
 
 template <typename T>
 class Priority_Queue {
@@ -42,6 +43,18 @@ private:
         }
     }
 
+    // When the array is full it is reallocated with doubled capacity: amortized O(1) per element.
+    void grow() {
+        int new_capacity = capacity > 0 ? capacity * 2 : 1;
+        T* new_heap_array = new T[new_capacity];
+        for (int i = 0; i < size; i++) {
+            new_heap_array[i] = heap_array[i];
+        }
+        delete[] heap_array;
+        heap_array = new_heap_array;
+        capacity = new_capacity;
+    }
+
 public:
     Priority_Queue() : size(0), capacity(20) {
         heap_array = new T[capacity];
@@ -51,13 +64,16 @@ public:
         heap_array = new T[capacity];
     }
 
+    Priority_Queue(const Priority_Queue&) = delete;
+    Priority_Queue& operator=(const Priority_Queue&) = delete;
+
     ~Priority_Queue() {
         delete[] heap_array;
     }
 
     void insert(const T& element) {
         if (size == capacity) {
-            throw std::out_of_range("Heap is full");
+            grow();
         }
         heap_array[size] = element;
         sift_up(size);
@@ -80,6 +96,11 @@ public:
         sift_down(0);
     }
 
+    int get_size() const { return size; }
+
+    // Empties the heap but keeps its array, for reuse across many searches.
+    void clear() { size = 0; }
+
     bool is_empty() const { return size == 0; }
 };
 
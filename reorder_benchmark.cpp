@@ -0,0 +1,195 @@
+// Vertex reordering report: the same graph under the original ids and under every order of graph_reorder.h, with the
+// time of each traversal of the repo and, where the kernel allows perf_event_open, the cache misses it caused.
+// Inputs: a road-like grid whose ids were shuffled (ids "from upstream") and an R-MAT graph (ids scrambled by the
+// generator). Results on a reordered graph are translated back to original ids and compared with the original run.
+// Usage: ./reorder_benchmark [grid_side] [rmat_scale]
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "csr_graph.h"
+#include "bfs.h"
+#include "dfs.h"
+#include "shortest_paths.h"
+#include "delta_stepping.h"
+#include "graph_generators.h"
+#include "graph_reorder.h"
+#include "thread_pool.h"
+#include "timing.h"
+#include "traversal_workspace.h"
+
+// Hardware cache misses of the calling thread (user space). Not available in many containers, then only time is shown.
+class Cache_Miss_Counter
+{
+    private:
+    int descriptor;
+
+    public:
+    Cache_Miss_Counter()
+    {
+        perf_event_attr attributes;
+        std::memset(&attributes, 0, sizeof(attributes));
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.size = sizeof(attributes);
+        attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        descriptor = int(syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+    }
+    ~Cache_Miss_Counter() { if (descriptor >= 0) { close(descriptor); } }
+
+    bool available() const { return descriptor >= 0; }
+
+    template <typename Function>
+    uint64_t count(Function function)
+    {
+        if (!available()) { function(); return 0; }
+        ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+        ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+        function();
+        ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t misses = 0;
+        if (read(descriptor, &misses, sizeof(misses)) != sizeof(misses)) { return 0; }
+        return misses;
+    }
+};
+
+struct Reference
+{
+    std::vector<int> depths;
+    std::vector<unsigned int> distances;
+    std::vector<std::vector<uint32_t>> neighbourhoods;
+};
+
+void run(const char* name, const CSR_Graph& graph, const Vertex_Order& order, double order_seconds,
+         Reference& reference, Cache_Miss_Counter& counter, Thread_Pool& pool)
+{
+    const uint32_t source = order.to_new(0);
+    std::vector<uint32_t> sources(64);
+    for (uint32_t i = 0; i < sources.size(); i++) { sources[i] = order.to_new(i * 7919 % graph.vertex_count()); }
+    bool correct = true;
+
+    std::cout << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(8) << order_seconds << std::setw(8) << std::setprecision(2) << average_log_gap(graph) << std::setprecision(4);
+    // counted = false for work on the pool's threads, which the counter does not see: "-" instead of a miss count.
+    auto report = [&](double seconds, uint64_t misses, bool counted = true) {
+        std::cout << std::setw(10) << seconds;
+        if (!counter.available()) { return; }
+        if (counted) { std::cout << std::setw(8) << std::setprecision(1) << misses / 1e6 << "M" << std::setprecision(4); }
+        else { std::cout << std::setw(9) << "-"; }
+    };
+
+    BFS_Result bfs;
+    uint64_t misses = 0;
+    double seconds = measure([&]() { misses = counter.count([&]() { bfs = top_down_bfs(graph, source); }); });
+    report(seconds, misses);
+    std::vector<int> depths = order.to_original(bfs.depths);
+    if (reference.depths.empty()) { reference.depths = depths; }
+    correct &= depths == reference.depths;
+
+    seconds = measure([&]() { misses = counter.count([&]() { bfs = direction_optimizing_bfs(graph, graph, source); }); });
+    report(seconds, misses);
+    correct &= order.to_original(bfs.depths) == reference.depths;
+
+    DFS_Workspace dfs_workspace;
+    DFS_Visitor visitor;
+    seconds = measure([&]() {
+        misses = counter.count([&]() {
+            dfs_workspace.reset(graph.vertex_count());
+            depth_first_search(graph, visitor, dfs_workspace);
+        });
+    });
+    report(seconds, misses);
+
+    Traversal_Workspace workspace;
+    seconds = measure([&]() { misses = counter.count([&]() { dijkstra(graph, source, workspace); }); });
+    report(seconds, misses);
+    std::vector<unsigned int> distances(graph.vertex_count());
+    for (uint32_t v = 0; v < graph.vertex_count(); v++) { distances[v] = workspace.distance(v); }
+    distances = order.to_original(distances);
+    if (reference.distances.empty()) { reference.distances = distances; }
+    correct &= distances == reference.distances;
+
+    Delta_Stepping delta_stepping(graph, pool);
+    std::vector<int> parents;
+    seconds = measure([&]() { delta_stepping.run(source, distances, parents); });
+    report(seconds, 0, false);
+    correct &= order.to_original(distances) == reference.distances;
+
+    std::vector<std::vector<uint32_t>> neighbourhoods;
+    seconds = measure([&]() { misses = counter.count([&]() { neighbourhoods = multi_source_neighbourhoods(graph, sources, 2); }); });
+    report(seconds, misses);
+    for (auto& neighbourhood : neighbourhoods)
+    {
+        for (uint32_t& v : neighbourhood) { v = order.to_original(v); }
+        std::sort(neighbourhood.begin(), neighbourhood.end());
+    }
+    if (reference.neighbourhoods.empty()) { reference.neighbourhoods = neighbourhoods; }
+    correct &= neighbourhoods == reference.neighbourhoods;
+
+    std::cout << (correct ? "" : "\tMISMATCH") << std::endl;
+}
+
+void run_orders(const char* name, const CSR_Graph& graph, Cache_Miss_Counter& counter, Thread_Pool& pool)
+{
+    std::cout << name << "\tvertices: " << graph.vertex_count() << "\tedges: " << graph.edge_count() << "\n"
+              << std::left << std::setw(12) << "order" << std::right << std::setw(8) << "order s" << std::setw(8) << "gap";
+    for (const char* traversal : {"BFS", "DO-BFS", "DFS", "Dijkstra", "Delta", "MS 2-hop"})
+    {
+        std::cout << std::setw(10) << traversal;
+        if (counter.available()) { std::cout << std::setw(9) << "misses"; }
+    }
+    std::cout << std::endl;
+
+    Reference reference;
+    run("original", graph, Vertex_Order::identity(graph.vertex_count()), 0, reference, counter, pool);
+
+    struct Named_Order
+    {
+        const char* name;
+        Vertex_Order (*compute)(const CSR_Graph&);
+    };
+    const Named_Order orders[] = {
+        {"degree", degree_order},
+        {"BFS", bfs_order},
+        {"RCM", reverse_cuthill_mckee},
+        {"Gorder-lite", [](const CSR_Graph& g) { return gorder_lite(g); }},
+    };
+    for (const Named_Order& named : orders)
+    {
+        Vertex_Order order;
+        double seconds = measure([&]() { order = named.compute(graph); });
+        run(named.name, reorder(graph, order), order, seconds, reference, counter, pool);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t side = argc > 1 ? std::atoi(argv[1]) : 1000;
+    uint32_t scale = argc > 2 ? std::atoi(argv[2]) : 18;
+
+    Thread_Pool pool;
+    Cache_Miss_Counter counter;
+    if (!counter.available()) { std::cout << "perf_event_open not permitted, cache misses are not shown" << std::endl; }
+
+    // Shuffled ids: a grid as it would arrive from a system which numbers vertices in no particular order.
+    CSR_Graph grid = generate_graph(Grid_Generator(side, side, 42), pool, true);
+    std::vector<uint32_t> shuffled(grid.vertex_count());
+    for (uint32_t v = 0; v < shuffled.size(); v++) { shuffled[v] = v; }
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(42));
+    run_orders("Grid, shuffled ids", grid.permuted(shuffled), counter, pool);
+
+    run_orders("R-MAT", generate_graph(RMAT_Generator(scale, 16, 42, 1000), pool, true), counter, pool);
+
+    return 0;
+}
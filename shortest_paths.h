@@ -0,0 +1,165 @@
+#ifndef SHORTEST_PATHS_HPP
+#define SHORTEST_PATHS_HPP
+
+// Single-source shortest paths over CSR_Graph. The same Dijkstra as dijkstra() in dijkstra.cpp, but instead of printing
+// the results stay in a Traversal_Workspace: distance(v) and parent(v) for every touched vertex, INF / -1 for the others.
+// A query which settles only the neighbourhood of the source costs only that neighbourhood, not O(V).
+//
+// Point-to-point queries do not need the whole graph. dijkstra() with an end stops as soon as end is settled.
+// bidirectional_dijkstra() grows a second search backward from end over the reversed graph and always advances
+// the side with the smaller heap:
+//
+//     start ( forward ) ( backward ) end        instead of        start (      forward      ) end
+//
+// Every edge relaxed towards a vertex which the other side has reached gives a candidate path, best is the shortest one.
+// The search stops when min(forward heap) + min(backward heap) >= best: any path not seen yet would be at least that long.
+// Two balls of radius d/2 settle far fewer vertices than one ball of radius d (about half in 2D, much less in expanders).
+
+#include <cstdint>
+#include <vector>
+#include "csr_graph.h"
+#include "priority_queue.h"
+#include "traversal_workspace.h"
+
+struct Heap_Entry {
+    public:
+    int vertex_id;
+    unsigned int distance;
+    Heap_Entry() : vertex_id(-1), distance(Traversal_Workspace::INF) {}
+    Heap_Entry(int vrtx_id, unsigned int distance_) : vertex_id(vrtx_id), distance(distance_) {}
+    bool operator<(const Heap_Entry& other) const { return this->distance < other.distance; }
+};
+
+// Weights must be non-negative. stop(u) is asked after every settled vertex u, the search ends when it returns true.
+// Returns the number of settled vertices. Graph is CSR_Graph or Compressed_Graph.
+template <typename Heap = Priority_Queue<Heap_Entry>, typename Graph, typename Stop>
+uint64_t dijkstra_until(const Graph& graph, uint32_t start, Traversal_Workspace& workspace, Stop stop)
+{
+    workspace.begin(graph.vertex_count());
+    workspace.visit(start);
+    workspace.set_distance(start, 0);
+
+    Heap min_heap;
+    min_heap.insert(Heap_Entry{int(start), 0});
+    uint64_t settled = 0;
+
+    while (!min_heap.is_empty())
+    {
+        Heap_Entry current = min_heap.min_peek();
+        min_heap.extract_peek();
+
+        uint32_t u = current.vertex_id;
+        if (current.distance > workspace.distance(u) || workspace.is_finished(u)) { continue; }
+        workspace.finish(u);
+        settled++;
+        if (stop(u)) { break; }
+
+        for (auto edge : graph.edges(u))
+        {
+            uint32_t v = edge.target;
+            unsigned int candidate = current.distance + edge.weight;
+
+            if (!workspace.is_visited(v)) { workspace.visit(v); }
+            if (candidate < workspace.distance(v))
+            {
+                workspace.set_distance(v, candidate);
+                workspace.set_parent(v, u);
+                min_heap.insert(Heap_Entry{int(v), candidate});
+            }
+        }
+    }
+    return settled;
+}
+
+// Stops as soon as end is settled (end = UINT32_MAX settles everything reachable). Returns the number of settled vertices.
+template <typename Heap = Priority_Queue<Heap_Entry>, typename Graph>
+uint64_t dijkstra(const Graph& graph, uint32_t start, Traversal_Workspace& workspace, uint32_t end = UINT32_MAX)
+{
+    return dijkstra_until<Heap>(graph, start, workspace, [end](uint32_t u) { return u == end; });
+}
+
+struct Bidirectional_Result {
+    public:
+    unsigned int distance;  // INF if end is unreachable.
+    int meeting_vertex;     // On the shortest path, -1 if there is none.
+    uint64_t settled;       // By both sides together.
+};
+
+// reversed must be graph.reversed() (the graph itself for undirected graphs). forward gets distances from start,
+// backward distances to end, both only for the vertices the searches reached.
+template <typename Heap = Priority_Queue<Heap_Entry>>
+Bidirectional_Result bidirectional_dijkstra(const CSR_Graph& graph, const CSR_Graph& reversed, uint32_t start, uint32_t end,
+                                            Traversal_Workspace& forward, Traversal_Workspace& backward)
+{
+    const CSR_Graph* graphs[2] = {&graph, &reversed};
+    Traversal_Workspace* workspaces[2] = {&forward, &backward};
+    Heap heaps[2];
+    uint32_t sources[2] = {start, end};
+    for (int side = 0; side < 2; side++)
+    {
+        workspaces[side]->begin(graph.vertex_count());
+        workspaces[side]->visit(sources[side]);
+        workspaces[side]->set_distance(sources[side], 0);
+        heaps[side].insert(Heap_Entry{int(sources[side]), 0});
+    }
+
+    Bidirectional_Result result{Traversal_Workspace::INF, -1, 0};
+    if (start == end) { result.distance = 0; result.meeting_vertex = start; return result; }
+
+    while (!heaps[0].is_empty() && !heaps[1].is_empty())
+    {
+        if (uint64_t(heaps[0].min_peek().distance) + heaps[1].min_peek().distance >= result.distance) { break; }
+
+        int side = heaps[0].get_size() <= heaps[1].get_size() ? 0 : 1;
+        Traversal_Workspace& self = *workspaces[side];
+        const Traversal_Workspace& other = *workspaces[1 - side];
+        Heap_Entry current = heaps[side].min_peek();
+        heaps[side].extract_peek();
+
+        uint32_t u = current.vertex_id;
+        if (current.distance > self.distance(u) || self.is_finished(u)) { continue; }
+        self.finish(u);
+        result.settled++;
+
+        for (uint64_t edge = graphs[side]->first_edge(u); edge < graphs[side]->last_edge(u); ++edge)
+        {
+            uint32_t v = graphs[side]->target(edge);
+            unsigned int candidate = current.distance + graphs[side]->weight(edge);
+
+            if (!self.is_visited(v)) { self.visit(v); }
+            if (candidate < self.distance(v))
+            {
+                self.set_distance(v, candidate);
+                self.set_parent(v, u);
+                heaps[side].insert(Heap_Entry{int(v), candidate});
+            }
+            if (other.distance(v) != Traversal_Workspace::INF && uint64_t(candidate) + other.distance(v) < result.distance)
+            {
+                result.distance = candidate + other.distance(v);
+                result.meeting_vertex = v;
+            }
+        }
+    }
+    return result;
+}
+
+// Path start -> ... -> end from the parents left by the last query, empty if end is unreachable.
+inline std::vector<uint32_t> extract_path(const Traversal_Workspace& workspace, uint32_t end)
+{
+    std::vector<uint32_t> path;
+    if (workspace.distance(end) == Traversal_Workspace::INF) { return path; }
+    for (int v = end; v != -1; v = workspace.parent(v)) { path.push_back(v); }
+    return std::vector<uint32_t>(path.rbegin(), path.rend());
+}
+
+// Path start -> ... -> end of a bidirectional query: forward parents up to the meeting vertex, backward parents after it.
+inline std::vector<uint32_t> extract_path(const Traversal_Workspace& forward, const Traversal_Workspace& backward,
+                                          const Bidirectional_Result& result)
+{
+    if (result.meeting_vertex == -1) { return {}; }
+    std::vector<uint32_t> path = extract_path(forward, result.meeting_vertex);
+    for (int v = backward.parent(result.meeting_vertex); v != -1; v = backward.parent(v)) { path.push_back(v); }
+    return path;
+}
+
+#endif // SHORTEST_PATHS_HPP
@@ -0,0 +1,499 @@
+#ifndef SPANNING_TREE_HPP
+#define SPANNING_TREE_HPP
+
+// Minimum spanning forests of large edge lists.
+//
+// filter_kruskal() (Osipov, Sanders, Singler) works on the caller's flat CSR_Edge array in place. Plain Kruskal sorts all m
+// edges, although on a dense graph the tree is complete after a small light fraction of them. Here quicksort-style:
+//
+//     [ ........................ edges ......................... ]
+//       partition around a pivot weight
+//     [ light (w <= pivot)      | heavy (w > pivot)               ]
+//       recurse into light -> tree edges among them are united
+//                                 filter: drop heavy edges whose ends are already in one set
+//                               [ heavy, still useful | dropped   ]
+//                                 recurse into the useful ones
+//
+// Small pieces are sorted and scanned like in Kruskal. Partitioning and filtering are parallel (parallel_partition(): every
+// thread partitions its own piece, then the misplaced elements of both sides are swapped), the base case uses parallel_sort.
+// Filtering only reads the disjoint sets (find_root() does not compress), unions happen in the sequential scan.
+// The array is reordered, never copied; no edge is lost. Disconnected input gives a minimum spanning forest.
+//
+// boruvka() contracts all components at once, every round in parallel:
+//   1. every edge offers itself to both of its components: atomic min of (weight, edge index) packed in 64 bits, so
+//      equal weights are ordered by index and the chosen edges never close a cycle;
+//   2. every component unites with the other end of its minimum edge in a Concurrent_Union_Find; the edge joins the forest
+//      if the union happened (two components which chose the same edge add it once);
+//   3. ends of the remaining edges are replaced by their roots, edges inside one component are partitioned away.
+// The number of components at least halves per round, hence O(log V) rounds over a shrinking edge list.
+// The input is only read, the working list holds (from, to, index) per edge; at most 2^32 - 1 edges.
+//
+// Prim, for a CSR_Graph which stores every edge in both directions:
+//   dense_prim()  - O(V^2) on a Weight_Matrix: per step one min-reduction over the keys of all vertices and one pass which
+//                   lowers them with the row of the new tree vertex. Both are straight passes over int32 arrays (SSE2 below),
+//                   no heap at all. Wins on near-complete graphs, where E ~ V^2 / 2 makes every heap-based method pay per edge.
+//   sparse_prim() - Indexed_Heap with decrease-key: at most V entries instead of one per edge. O(E + V log V) heap work.
+// Both start a new tree from the next vertex outside the forest when the heap (or every key) runs dry, so disconnected
+// input gives a spanning forest, never a partial tree.
+//
+// minimum_spanning_forest() picks one of the four from V, E, the density E / (V (V - 1) / 2) and the form of the input,
+// see choose_mst_algorithm().
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "concurrent_union_find.h"
+#include "csr_graph.h"
+#include "indexed_heap.h"
+#include "thread_pool.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Union by rank, path halving. find_root() walks without writing, so it may run in many threads while nobody unites.
+class Union_Find
+{
+    private:
+    std::vector<uint32_t> parent;
+    std::vector<uint8_t> rank;
+
+    public:
+    explicit Union_Find(uint32_t vertices) : parent(vertices), rank(vertices, 0)
+    {
+        for (uint32_t v = 0; v < vertices; v++) { parent[v] = v; }
+    }
+
+    uint32_t find(uint32_t v)
+    {
+        while (parent[v] != v)
+        {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    }
+
+    uint32_t find_root(uint32_t v) const
+    {
+        while (parent[v] != v) { v = parent[v]; }
+        return v;
+    }
+
+    // false if u and v already were in one set.
+    bool unite(uint32_t u, uint32_t v)
+    {
+        u = find(u);
+        v = find(v);
+        if (u == v) { return false; }
+        if (rank[u] < rank[v]) { std::swap(u, v); }
+        parent[v] = u;
+        if (rank[u] == rank[v]) { rank[u]++; }
+        return true;
+    }
+};
+
+struct Spanning_Forest
+{
+    public:
+    std::vector<CSR_Edge> edges;
+    int64_t total_weight = 0;
+};
+
+// Textbook Kruskal: sort by weight, scan with Union_Find. The reference the faster algorithms are checked against.
+inline Spanning_Forest sorting_kruskal(std::vector<CSR_Edge> edges, uint32_t vertices)
+{
+    std::sort(edges.begin(), edges.end(), [](const CSR_Edge& a, const CSR_Edge& b) { return a.weight < b.weight; });
+    Union_Find sets(vertices);
+    Spanning_Forest forest;
+    for (const CSR_Edge& edge : edges)
+    {
+        if (sets.unite(edge.vertex_from, edge.vertex_to))
+        {
+            forest.edges.push_back(edge);
+            forest.total_weight += edge.weight;
+        }
+    }
+    return forest;
+}
+
+// Moves the elements for which is_left holds to the front, returns their number. Order inside both sides is not kept.
+template <typename Element, typename Predicate>
+uint64_t parallel_partition(Element* elements, uint64_t count, Predicate is_left, Thread_Pool& pool)
+{
+    uint64_t pieces = uint64_t(pool.size()) * 4;
+    if (pool.size() == 1 || count < (1 << 16)) { return std::partition(elements, elements + count, is_left) - elements; }
+
+    auto bound = [&](uint64_t piece) { return count * piece / pieces; };
+    std::vector<uint64_t> left(pieces);
+    pool.parallel_for(0, pieces, [&](uint64_t piece, int) {
+        left[piece] = std::partition(elements + bound(piece), elements + bound(piece + 1), is_left) - (elements + bound(piece));
+    }, 1);
+    uint64_t total = 0;
+    for (uint64_t count_left : left) { total += count_left; }
+
+    // Right elements in [0, total) and left elements in [total, count) are misplaced, and there are as many of one as of
+    // the other. Both are lists of intervals (one per piece at most); the k-th of one list is swapped with the k-th of the other.
+    struct Interval { uint64_t begin, end, before; };
+    std::vector<Interval> wrong_right, wrong_left;
+    uint64_t right_total = 0, left_total = 0;
+    for (uint64_t piece = 0; piece < pieces; piece++)
+    {
+        uint64_t split = bound(piece) + left[piece];
+        uint64_t begin = split, end = std::min(bound(piece + 1), total);
+        if (begin < end) { wrong_right.push_back({begin, end, right_total}); right_total += end - begin; }
+        begin = std::max(bound(piece), total), end = split;
+        if (begin < end) { wrong_left.push_back({begin, end, left_total}); left_total += end - begin; }
+    }
+    auto locate = [](const std::vector<Interval>& intervals, uint64_t k) {
+        auto it = std::upper_bound(intervals.begin(), intervals.end(), k, [](uint64_t value, const Interval& interval) { return value < interval.before; });
+        --it;
+        return it->begin + (k - it->before);
+    };
+    pool.parallel_for(0, right_total, [&](uint64_t k, int) {
+        std::swap(elements[locate(wrong_right, k)], elements[locate(wrong_left, k)]);
+    }, 1 << 12);
+    return total;
+}
+
+class Filter_Kruskal
+{
+    private:
+    Union_Find sets;
+    Spanning_Forest forest;
+    uint32_t vertices;
+    uint64_t base_size;
+    Thread_Pool& pool;
+
+    bool complete() const { return forest.edges.size() + 1 >= vertices; }
+
+    void kruskal(CSR_Edge* edges, uint64_t count)
+    {
+        parallel_sort(edges, edges + count, [](const CSR_Edge& a, const CSR_Edge& b) { return a.weight < b.weight; }, pool);
+        for (uint64_t i = 0; i < count && !complete(); i++)
+        {
+            if (sets.unite(edges[i].vertex_from, edges[i].vertex_to))
+            {
+                forest.edges.push_back(edges[i]);
+                forest.total_weight += edges[i].weight;
+            }
+        }
+    }
+
+    // Median of a sample spread over the whole range by a multiplicative hash of the position.
+    int32_t pivot(const CSR_Edge* edges, uint64_t count) const
+    {
+        std::vector<int32_t> sample(63);
+        for (uint64_t i = 0; i < sample.size(); i++) { sample[i] = edges[(i * 0x9e3779b97f4a7c15ull >> 7) % count].weight; }
+        std::nth_element(sample.begin(), sample.begin() + sample.size() / 2, sample.end());
+        return sample[sample.size() / 2];
+    }
+
+    void filter_kruskal(CSR_Edge* edges, uint64_t count)
+    {
+        if (complete() || count == 0) { return; }
+        if (count <= base_size) { kruskal(edges, count); return; }
+
+        int32_t weight = pivot(edges, count);
+        uint64_t light = parallel_partition(edges, count, [&](const CSR_Edge& edge) { return edge.weight <= weight; }, pool);
+        if (light == count) { kruskal(edges, count); return; } // Mostly equal weights, the pivot splits nothing off.
+        filter_kruskal(edges, light);
+        if (complete()) { return; }
+
+        CSR_Edge* heavy = edges + light;
+        uint64_t useful = parallel_partition(heavy, count - light, [&](const CSR_Edge& edge) {
+            return sets.find_root(edge.vertex_from) != sets.find_root(edge.vertex_to);
+        }, pool);
+        filter_kruskal(heavy, useful);
+    }
+
+    public:
+    // base_size - pieces up to this many edges are sorted; 0 = max(vertices, 4096).
+    Filter_Kruskal(uint32_t vertices_, Thread_Pool& pool_, uint64_t base_size_ = 0)
+        : sets(vertices_), vertices(vertices_), base_size(base_size_ ? base_size_ : std::max<uint64_t>(vertices_, 4096)), pool(pool_) {}
+
+    Spanning_Forest run(CSR_Edge* edges, uint64_t count)
+    {
+        forest.edges.reserve(vertices ? vertices - 1 : 0);
+        filter_kruskal(edges, count);
+        return std::move(forest);
+    }
+};
+
+// Reorders edges in place. Weights of the result are summed in 64 bits.
+inline Spanning_Forest filter_kruskal(std::vector<CSR_Edge>& edges, uint32_t vertices, Thread_Pool& pool)
+{
+    return Filter_Kruskal(vertices, pool).run(edges.data(), edges.size());
+}
+
+inline Spanning_Forest boruvka(const std::vector<CSR_Edge>& edges, uint32_t vertices, Thread_Pool& pool)
+{
+    if (edges.size() >= UINT32_MAX) { throw std::invalid_argument("boruvka: edge indices must fit into 32 bits"); }
+    struct Working_Edge { uint32_t from, to, index; };
+    std::vector<Working_Edge> working(edges.size());
+    pool.parallel_for(0, edges.size(), [&](uint64_t i, int) { working[i] = {edges[i].vertex_from, edges[i].vertex_to, uint32_t(i)}; }, 1 << 14);
+    uint64_t count = parallel_partition(working.data(), working.size(), [](const Working_Edge& edge) { return edge.from != edge.to; }, pool);
+
+    Concurrent_Union_Find sets(vertices);
+    std::unique_ptr<std::atomic<uint64_t>[]> best(new std::atomic<uint64_t>[vertices]);
+    std::vector<uint32_t> components(vertices), chosen(vertices ? vertices - 1 : 0);
+    for (uint32_t v = 0; v < vertices; v++) { components[v] = v; }
+    std::atomic<uint64_t> chosen_count(0);
+    auto key = [&](uint32_t index) { return uint64_t(uint32_t(edges[index].weight) ^ 0x80000000u) << 32 | index; };
+    auto offer = [&](uint32_t component, uint64_t value) {
+        uint64_t current = best[component].load(std::memory_order_relaxed);
+        while (value < current && !best[component].compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    };
+
+    while (count > 0)
+    {
+        pool.parallel_for(0, components.size(), [&](uint64_t i, int) { best[components[i]].store(UINT64_MAX, std::memory_order_relaxed); }, 1 << 14);
+        pool.parallel_for(0, count, [&](uint64_t i, int) {
+            uint64_t value = key(working[i].index);
+            offer(working[i].from, value);
+            offer(working[i].to, value);
+        }, 1 << 14);
+        pool.parallel_for(0, components.size(), [&](uint64_t i, int) {
+            uint64_t value = best[components[i]].load(std::memory_order_relaxed);
+            if (value == UINT64_MAX) { return; }
+            const CSR_Edge& edge = edges[uint32_t(value)];
+            if (sets.unite(edge.vertex_from, edge.vertex_to)) { chosen[chosen_count.fetch_add(1, std::memory_order_relaxed)] = uint32_t(value); }
+        }, 1 << 12);
+
+        uint64_t roots = parallel_partition(components.data(), components.size(), [&](uint32_t c) { return sets.is_root(c); }, pool);
+        components.resize(roots);
+        pool.parallel_for(0, count, [&](uint64_t i, int) {
+            working[i].from = sets.find(working[i].from);
+            working[i].to = sets.find(working[i].to);
+        }, 1 << 14);
+        count = parallel_partition(working.data(), count, [](const Working_Edge& edge) { return edge.from != edge.to; }, pool);
+    }
+
+    chosen.resize(chosen_count.load());
+    std::sort(chosen.begin(), chosen.end());
+    Spanning_Forest forest;
+    forest.edges.reserve(chosen.size());
+    for (uint32_t index : chosen)
+    {
+        forest.edges.push_back(edges[index]);
+        forest.total_weight += edges[index].weight;
+    }
+    return forest;
+}
+
+// Every undirected edge once (from < to), for the edge-list algorithms. Self-loops are dropped.
+inline std::vector<CSR_Edge> undirected_edge_list(const CSR_Graph& graph)
+{
+    std::vector<CSR_Edge> edges;
+    edges.reserve(graph.edge_count() / 2);
+    for (uint32_t u = 0; u < graph.vertex_count(); u++)
+    {
+        for (uint64_t edge = graph.first_edge(u); edge < graph.last_edge(u); edge++)
+        {
+            if (u < graph.target(edge)) { edges.emplace_back(u, graph.target(edge), graph.weight(edge)); }
+        }
+    }
+    return edges;
+}
+
+// Row-major V x V weights, NO_EDGE where two vertices are not adjacent (and on the diagonal). Parallel edges keep the lightest.
+// NO_EDGE is INT32_MAX, so edge weights must be below it; set() and from_graph() throw std::invalid_argument otherwise.
+class Weight_Matrix
+{
+    public:
+    static constexpr int32_t NO_EDGE = INT32_MAX;
+
+    private:
+    uint32_t n;
+    std::vector<int32_t> weights;
+
+    public:
+    explicit Weight_Matrix(uint32_t vertices = 0) : n(vertices), weights(uint64_t(vertices) * vertices, NO_EDGE) {}
+
+    static Weight_Matrix from_graph(const CSR_Graph& graph)
+    {
+        Weight_Matrix matrix(graph.vertex_count());
+        for (uint32_t u = 0; u < graph.vertex_count(); u++)
+        {
+            for (uint64_t edge = graph.first_edge(u); edge < graph.last_edge(u); edge++)
+            {
+                uint32_t v = graph.target(edge);
+                if (u != v) { matrix.set(u, v, std::min(matrix.at(u, v), graph.weight(edge))); }
+            }
+        }
+        return matrix;
+    }
+
+    uint32_t vertex_count() const { return n; }
+    int32_t at(uint32_t u, uint32_t v) const { return weights[uint64_t(u) * n + v]; }
+    void set(uint32_t u, uint32_t v, int32_t weight)
+    {
+        if (weight == NO_EDGE) { throw std::invalid_argument("Weight_Matrix: weight INT32_MAX is reserved for NO_EDGE"); }
+        weights[uint64_t(u) * n + v] = weight;
+    }
+    const int32_t* row(uint32_t u) const { return weights.data() + uint64_t(u) * n; }
+    uint64_t memory_bytes() const { return weights.size() * sizeof(int32_t); }
+};
+
+// Smallest of keys[0..n).
+inline int32_t dense_min(const int32_t* keys, uint32_t n)
+{
+    uint32_t i = 0;
+    int32_t result = INT32_MAX;
+#if defined(__SSE2__)
+    // SSE2 has no 32-bit min, it is compare + select. Four lanes, reduced once at the end.
+    __m128i best = _mm_set1_epi32(INT32_MAX);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+        __m128i smaller = _mm_cmplt_epi32(chunk, best);
+        best = _mm_or_si128(_mm_and_si128(smaller, chunk), _mm_andnot_si128(smaller, best));
+    }
+    alignas(16) int32_t lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), best);
+    for (int32_t lane : lanes) { result = std::min(result, lane); }
+#endif
+    for (; i < n; i++) { result = std::min(result, keys[i]); }
+    return result;
+}
+
+// keys[v] = min(keys[v], row[v]) with parents[v] = u where it got smaller, for every v outside the tree (outside[v] = -1).
+inline void dense_relax(const int32_t* row, int32_t* keys, int32_t* parents, const int32_t* outside, int32_t u, uint32_t n)
+{
+    uint32_t i = 0;
+#if defined(__SSE2__)
+    __m128i from = _mm_set1_epi32(u);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i weight = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+        __m128i key = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+        __m128i parent = _mm_loadu_si128(reinterpret_cast<const __m128i*>(parents + i));
+        __m128i better = _mm_and_si128(_mm_cmplt_epi32(weight, key), _mm_loadu_si128(reinterpret_cast<const __m128i*>(outside + i)));
+        key = _mm_or_si128(_mm_and_si128(better, weight), _mm_andnot_si128(better, key));
+        parent = _mm_or_si128(_mm_and_si128(better, from), _mm_andnot_si128(better, parent));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(keys + i), key);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(parents + i), parent);
+    }
+#endif
+    for (; i < n; i++)
+    {
+        if (outside[i] && row[i] < keys[i]) { keys[i] = row[i]; parents[i] = u; }
+    }
+}
+
+inline Spanning_Forest dense_prim(const Weight_Matrix& matrix)
+{
+    uint32_t n = matrix.vertex_count();
+    // Vertices of the forest keep the key NO_EDGE, so the min-reduction needs no mask.
+    std::vector<int32_t> keys(n, Weight_Matrix::NO_EDGE), parents(n, -1), outside(n, -1);
+    Spanning_Forest forest;
+    uint32_t next_root = 0;
+    for (uint32_t added = 0; added < n; added++)
+    {
+        int32_t best = dense_min(keys.data(), n);
+        uint32_t u;
+        if (best == Weight_Matrix::NO_EDGE)
+        {
+            while (!outside[next_root]) { next_root++; } // Nothing reachable from the forest: a new tree starts.
+            u = next_root;
+        }
+        else
+        {
+            u = uint32_t(std::find(keys.begin(), keys.end(), best) - keys.begin());
+            forest.edges.emplace_back(uint32_t(parents[u]), u, best);
+            forest.total_weight += best;
+        }
+        outside[u] = 0;
+        keys[u] = Weight_Matrix::NO_EDGE;
+        dense_relax(matrix.row(u), keys.data(), parents.data(), outside.data(), int32_t(u), n);
+    }
+    return forest;
+}
+
+inline Spanning_Forest sparse_prim(const CSR_Graph& graph)
+{
+    uint32_t n = graph.vertex_count();
+    Indexed_Heap<int32_t> heap(n);
+    std::vector<bool> in_forest(n, false);
+    std::vector<uint32_t> parents(n, UINT32_MAX);
+    Spanning_Forest forest;
+    for (uint32_t root = 0; root < n; root++)
+    {
+        if (in_forest[root]) { continue; }
+        heap.push_or_decrease(root, INT32_MIN);
+        while (!heap.is_empty())
+        {
+            int32_t key = heap.key(heap.min_peek());
+            uint32_t u = heap.extract_peek();
+            in_forest[u] = true;
+            if (parents[u] != UINT32_MAX)
+            {
+                forest.edges.emplace_back(parents[u], u, key);
+                forest.total_weight += key;
+            }
+            for (uint64_t edge = graph.first_edge(u); edge < graph.last_edge(u); edge++)
+            {
+                uint32_t v = graph.target(edge);
+                if (!in_forest[v] && heap.push_or_decrease(v, graph.weight(edge))) { parents[v] = u; }
+            }
+        }
+    }
+    return forest;
+}
+
+enum class MST_Algorithm { automatic, prim_dense, prim_sparse, kruskal, boruvka };
+
+inline const char* mst_algorithm_name(MST_Algorithm algorithm)
+{
+    switch (algorithm)
+    {
+        case MST_Algorithm::prim_dense: return "Prim, dense";
+        case MST_Algorithm::prim_sparse: return "Prim, sparse";
+        case MST_Algorithm::kruskal: return "filter-Kruskal";
+        case MST_Algorithm::boruvka: return "Boruvka";
+        default: return "automatic";
+    }
+}
+
+// edges counts both directions, as CSR_Graph::edge_count() does. matrix - the weights already are a Weight_Matrix.
+//   matrix input                                  -> Prim, dense: one pass over V^2 keys, nothing to convert.
+//   several threads, >= 2^22 edges, density < 1%  -> Boruvka, the only one of them which is parallel all the way.
+//   density >= 1%                                 -> Prim, sparse: few heap entries, every edge costs one comparison.
+//   otherwise                                     -> filter-Kruskal: large sparse graphs, sorting short pieces is cheaper
+//                                                    than the cache misses of a heap over the whole vertex range.
+// A CSR_Graph never selects dense Prim: filling the matrix from it costs more than sparse Prim on the same graph.
+inline MST_Algorithm choose_mst_algorithm(uint32_t vertices, uint64_t edges, int threads, bool matrix = false)
+{
+    if (matrix) { return MST_Algorithm::prim_dense; }
+    if (vertices < 2) { return MST_Algorithm::prim_sparse; }
+    double density = double(edges) / (double(vertices) * (vertices - 1));
+    if (threads > 1 && edges >= (1ull << 22) && density < 0.01) { return MST_Algorithm::boruvka; }
+    if (density >= 0.01) { return MST_Algorithm::prim_sparse; }
+    return MST_Algorithm::kruskal;
+}
+
+// graph stores every edge in both directions (CSR_Graph::from_edges(..., true)). A spanning forest for disconnected input.
+inline Spanning_Forest minimum_spanning_forest(const CSR_Graph& graph, Thread_Pool& pool, MST_Algorithm algorithm = MST_Algorithm::automatic)
+{
+    if (algorithm == MST_Algorithm::automatic) { algorithm = choose_mst_algorithm(graph.vertex_count(), graph.edge_count(), pool.size()); }
+    switch (algorithm)
+    {
+        case MST_Algorithm::prim_dense: return dense_prim(Weight_Matrix::from_graph(graph));
+        case MST_Algorithm::kruskal:
+        {
+            std::vector<CSR_Edge> edges = undirected_edge_list(graph);
+            return filter_kruskal(edges, graph.vertex_count(), pool);
+        }
+        case MST_Algorithm::boruvka: return boruvka(undirected_edge_list(graph), graph.vertex_count(), pool);
+        default: return sparse_prim(graph);
+    }
+}
+
+inline Spanning_Forest minimum_spanning_forest(const Weight_Matrix& matrix) { return dense_prim(matrix); }
+
+#endif // SPANNING_TREE_HPP
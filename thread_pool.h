@@ -0,0 +1,137 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+// Fixed set of worker threads which live as long as the pool. Creating threads for every BFS level or every Boruvka round
+// would cost more than the work itself on small levels, so parallel algorithms borrow threads from a pool instead.
+//
+// run(task)                         - every thread calls task(thread_index) once, returns when all of them are done.
+// parallel_for(begin, end, body)    - body(index, thread_index) for every index, indices are handed out in chunks
+//                                     through an atomic counter, so uneven work (vertices of very different degree) balances itself.
+//
+// parallel_sort(first, last, less, pool) - pieces sorted by all threads, then merged pairwise, one level per round.
+//
+// The calling thread takes part as thread 0, therefore Thread_Pool(1) runs everything inline without any worker.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Thread_Pool
+{
+    private:
+    std::vector<std::thread> workers;
+    std::mutex lock;
+    std::condition_variable wake_up;
+    std::condition_variable done;
+    std::function<void(int)> task;
+    uint64_t generation = 0;
+    int running = 0;
+    bool stopping = false;
+
+    void worker_loop(int thread_index)
+    {
+        uint64_t seen_generation = 0;
+        while (true)
+        {
+            std::function<void(int)>* current = nullptr;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake_up.wait(guard, [&]() { return stopping || generation != seen_generation; });
+                if (stopping) { return; }
+                seen_generation = generation;
+                current = &task;
+            }
+            (*current)(thread_index);
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                if (--running == 0) { done.notify_one(); }
+            }
+        }
+    }
+
+    public:
+    explicit Thread_Pool(int threads = std::max(1u, std::thread::hardware_concurrency()))
+    {
+        for (int i = 1; i < threads; i++)
+        {
+            workers.emplace_back(&Thread_Pool::worker_loop, this, i);
+        }
+    }
+
+    Thread_Pool(const Thread_Pool&) = delete;
+    Thread_Pool& operator=(const Thread_Pool&) = delete;
+
+    ~Thread_Pool()
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wake_up.notify_all();
+        for (auto& worker : workers) { worker.join(); }
+    }
+
+    int size() const { return int(workers.size()) + 1; }
+
+    void run(const std::function<void(int)>& function)
+    {
+        if (workers.empty()) { function(0); return; }
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            task = function;
+            running = int(workers.size());
+            generation++;
+        }
+        wake_up.notify_all();
+        function(0);
+        std::unique_lock<std::mutex> guard(lock);
+        done.wait(guard, [&]() { return running == 0; });
+    }
+
+    template <typename Body>
+    void parallel_for(uint64_t begin, uint64_t end, Body body, uint64_t chunk = 1024)
+    {
+        if (begin >= end) { return; }
+        if (workers.empty() || end - begin <= chunk)
+        {
+            for (uint64_t i = begin; i < end; i++) { body(i, 0); }
+            return;
+        }
+        std::atomic<uint64_t> next(begin);
+        run([&](int thread_index) {
+            while (true)
+            {
+                uint64_t first = next.fetch_add(chunk);
+                if (first >= end) { break; }
+                uint64_t last = std::min(end, first + chunk);
+                for (uint64_t i = first; i < last; i++) { body(i, thread_index); }
+            }
+        });
+    }
+};
+
+template <typename Iterator, typename Less>
+void parallel_sort(Iterator first, Iterator last, Less less, Thread_Pool& pool)
+{
+    uint64_t count = last - first;
+    uint64_t pieces = 1;
+    while (pieces < uint64_t(pool.size()) && count / (pieces * 2) >= (1 << 14)) { pieces *= 2; }
+    if (pieces == 1) { std::sort(first, last, less); return; }
+
+    auto bound = [&](uint64_t piece) { return first + count * piece / pieces; };
+    pool.parallel_for(0, pieces, [&](uint64_t piece, int) { std::sort(bound(piece), bound(piece + 1), less); }, 1);
+    for (uint64_t width = 1; width < pieces; width *= 2)
+    {
+        pool.parallel_for(0, pieces / (2 * width), [&](uint64_t pair, int) {
+            uint64_t left = pair * 2 * width;
+            std::inplace_merge(bound(left), bound(left + width), bound(left + 2 * width), less);
+        }, 1);
+    }
+}
+
+#endif // THREAD_POOL_HPP
@@ -0,0 +1,17 @@
+#ifndef TIMING_HPP
+#define TIMING_HPP
+
+// Wall-clock timing for the benchmark programs: double seconds = measure([&]() { ... });
+// steady_clock, so the result never jumps with adjustments of the system clock.
+
+#include <chrono>
+
+template <typename Function>
+double measure(Function function)
+{
+    auto begin = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+#endif // TIMING_HPP
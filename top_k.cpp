@@ -0,0 +1,74 @@
+// Benchmark of the streaming top-k accumulator: "top 100 of a huge stream of events".
+// Compares offering elements one by one with the batched offer() which rejects whole blocks with SIMD,
+// then splits the stream between threads and merges per-thread accumulators at the end.
+// Result is checked against std::nth_element over the whole stream.
+// Usage: ./top_k [number_of_events] [k]
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include "timing.h"
+#include "top_k.h"
+
+void report(const char* name, double seconds, size_t n)
+{
+    std::cout << name << seconds << " s\t" << n * sizeof(int) / seconds / 1e9 << " GB/s" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t n = argc > 1 ? std::atoll(argv[1]) : 50000000;
+    size_t k = argc > 2 ? std::atoll(argv[2]) : 100;
+    k = std::min(k, n); // nth_element and resize need k <= n.
+
+    std::vector<int> events(n);
+    std::mt19937 rng(42);
+    for (auto& event : events) { event = static_cast<int>(rng() >> 1); }
+
+    std::vector<int> expected = events;
+    std::nth_element(expected.begin(), expected.begin() + k, expected.end(), std::greater<int>());
+    expected.resize(k);
+    std::sort(expected.begin(), expected.end(), std::greater<int>());
+
+    std::cout << "Events: " << n << "\tk: " << k << std::endl;
+
+    Top_K<int> one_by_one(k);
+    double seconds = measure([&]() { for (int event : events) { one_by_one.offer(event); } });
+    report("offer(value) one by one:\t", seconds, n);
+
+    Top_K<int> batched(k);
+    seconds = measure([&]() { batched.offer(events); });
+    report("offer(values) batched:\t\t", seconds, n);
+
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    Top_K<int> merged(k);
+    seconds = measure([&]() {
+        std::mutex merge_lock;
+        std::vector<std::thread> workers;
+        size_t chunk = (n + threads - 1) / threads;
+        for (unsigned t = 0; t < threads; t++)
+        {
+            workers.emplace_back([&, t]() {
+                size_t begin = std::min(n, t * chunk);
+                size_t end = std::min(n, begin + chunk);
+                Top_K<int> accumulator(k);
+                accumulator.offer(events.data() + begin, end - begin);
+                std::lock_guard<std::mutex> guard(merge_lock);
+                merged.merge(accumulator);
+            });
+        }
+        for (auto& worker : workers) { worker.join(); }
+    });
+    std::cout << "threads: " << threads << "\t";
+    report("per-thread + merge:\t", seconds, n);
+
+    bool correct = one_by_one.result() == expected && batched.result() == expected && merged.result() == expected;
+    std::cout << (correct ? "Top-k matches std::nth_element." : "MISMATCH with std::nth_element!") << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+#ifndef TOP_K_HPP
+#define TOP_K_HPP
+
+// Streaming top-k selection. Only the k greatest elements seen so far are kept, inside a min_heap of size k.
+// The root of that heap is the threshold: the smallest element which is still in the top.
+// A new element not greater than the threshold is rejected in O(1), otherwise it replaces the root with one sift down: O(log k).
+// Memory is O(k) no matter how long the stream is.
+//
+//    stream: 5 1 9 3 7 8 2 ...   k = 3
+//    [5 1 9] -> threshold 1 -> 3 replaces 1 -> threshold 3 -> 7 replaces 3 -> threshold 5 -> 8 replaces 5 -> 2 rejected
+//
+// After the first few thousand elements almost everything is rejected, so offer(values, count) checks whole blocks
+// against the threshold with SIMD first and touches the heap only for blocks which contain a candidate.
+// Accumulators of different threads are combined with merge().
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include "binary_heap.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+template <typename T>
+class Top_K {
+private:
+    static constexpr size_t block_size = 64;
+
+    size_t k;
+    Max_Heap<T, std::greater<T>> heap; // min_heap: the smallest of the top-k is on the root.
+
+    // Plain loop without early exit, the compiler is able to vectorize it for arithmetic types.
+    static bool block_has_greater(const T* values, size_t count, const T& threshold)
+    {
+        bool found = false;
+        for (size_t i = 0; i < count; i++) { found |= threshold < values[i]; }
+        return found;
+    }
+
+    void offer_block(const T* values, size_t count)
+    {
+        for (size_t i = 0; i < count; i++) { offer(values[i]); }
+    }
+
+public:
+    Top_K(size_t k_) : k(k_), heap(k_ > 0 ? k_ : 1) {}
+
+    void offer(const T& value)
+    {
+        if (heap.get_size() < k) { heap.push(value); }
+        else if (k > 0 && heap.peek() < value) { heap.replace_peek(value); }
+    }
+
+    void offer(const T* values, size_t count)
+    {
+        size_t i = 0;
+        while (i < count && heap.get_size() < k) { offer(values[i++]); }
+        if (k == 0) { return; }
+
+        for (; i < count; i += block_size)
+        {
+            size_t length = std::min(block_size, count - i);
+            if (block_has_greater(values + i, length, heap.peek())) { offer_block(values + i, length); }
+        }
+    }
+
+    void offer(const std::vector<T>& values) { offer(values.data(), values.size()); }
+
+    void merge(const Top_K& other)
+    {
+        offer(other.heap.data(), other.heap.get_size());
+    }
+
+    // Threshold to beat. Meaningful only when the accumulator is full.
+    const T& threshold() const { return heap.peek(); }
+
+    size_t get_size() const { return heap.get_size(); }
+
+    // The top-k in descending order.
+    std::vector<T> result() const
+    {
+        std::vector<T> top(heap.data(), heap.data() + heap.get_size());
+        std::sort(top.begin(), top.end(), std::greater<T>());
+        return top;
+    }
+};
+
+#if defined(__SSE2__)
+// Explicit SSE2 version for int: four comparisons per instruction, results are OR-ed and tested once per block.
+template <>
+inline bool Top_K<int>::block_has_greater(const int* values, size_t count, const int& threshold)
+{
+    __m128i limit = _mm_set1_epi32(threshold);
+    __m128i found = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        found = _mm_or_si128(found, _mm_cmpgt_epi32(chunk, limit));
+    }
+    bool result = _mm_movemask_epi8(found) != 0;
+    for (; i < count; i++) { result |= values[i] > threshold; }
+    return result;
+}
+#endif
+
+#endif // TOP_K_HPP
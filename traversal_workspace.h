@@ -0,0 +1,73 @@
+#ifndef TRAVERSAL_WORKSPACE_HPP
+#define TRAVERSAL_WORKSPACE_HPP
+
+// Reusable per-vertex state for traversals and shortest paths which usually touch a small part of a big graph.
+// Instead of std::vector<bool> visited(V, false) (O(V) allocation and zero-fill for every query) every vertex keeps
+// the number of the query (epoch) which touched it last:
+//
+//     stamp:   [ 7  3  7  7  0  5 ]     epoch = 7  ->  visited: 0, 2, 3
+//     begin()  ->  epoch = 9            ->  visited: nothing, without touching the array
+//
+// Distances and parents are meaningful only for vertices stamped in the current epoch, so they are not cleared either.
+// Starting a query is O(1); the array is wiped only once every 2^31 queries when the counter wraps around.
+// Every vertex stamped in the query is remembered in touched(), a sparse answer is read from there.
+// Each epoch has two states (visited and finished), DFS needs both. One workspace per thread.
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class Traversal_Workspace
+{
+    public:
+    static constexpr unsigned int INF = std::numeric_limits<unsigned int>::max();
+
+    private:
+    std::vector<uint32_t> stamp;
+    std::vector<unsigned int> distances;
+    std::vector<int> parents;
+    std::vector<uint32_t> touched_vertices;
+    uint32_t epoch = 0;
+
+    public:
+    // Starts a new query on a graph with the given number of vertices. Allocates only when the graph got bigger.
+    void begin(uint32_t vertices)
+    {
+        if (stamp.size() < vertices)
+        {
+            stamp.resize(vertices, 0);
+            distances.resize(vertices, INF);
+            parents.resize(vertices, -1);
+        }
+        epoch += 2;
+        if (epoch >= std::numeric_limits<uint32_t>::max() - 2)
+        {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            epoch = 2;
+        }
+        touched_vertices.clear();
+    }
+
+    bool is_visited(uint32_t v) const { return stamp[v] >= epoch; }
+    bool is_finished(uint32_t v) const { return stamp[v] == epoch + 1; }
+
+    // First touch of the vertex in this query: distance INF, no parent.
+    void visit(uint32_t v)
+    {
+        stamp[v] = epoch;
+        distances[v] = INF;
+        parents[v] = -1;
+        touched_vertices.push_back(v);
+    }
+    void finish(uint32_t v) { stamp[v] = epoch + 1; }
+
+    unsigned int distance(uint32_t v) const { return is_visited(v) ? distances[v] : INF; }
+    int parent(uint32_t v) const { return is_visited(v) ? parents[v] : -1; }
+    void set_distance(uint32_t v, unsigned int distance) { distances[v] = distance; }
+    void set_parent(uint32_t v, int parent) { parents[v] = parent; }
+
+    const std::vector<uint32_t>& touched() const { return touched_vertices; }
+};
+
+#endif // TRAVERSAL_WORKSPACE_HPP
@@ -0,0 +1,72 @@
+// Throughput of Concurrent_Union_Find: a stream of random operations (unite, or same_set for a given share of them)
+// over all cores, 1, 2, 4, ... threads up to all of them. Operation i is a pure function of i, so every thread count
+// performs the same operations and must end with the same partition, which is compared with the sequential
+// Union_Find of spanning_tree.h for the unions alone.
+// Usage: ./union_find_benchmark [vertices] [operations] [same_set_percent]     (default 10^7 vertices, 10^9 operations)
+
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+#include <thread>
+#include "concurrent_union_find.h"
+#include "graph_generators.h"
+#include "spanning_tree.h"
+#include "thread_pool.h"
+#include "timing.h"
+
+int main(int argc, char* argv[])
+{
+    uint32_t vertices = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    uint64_t operations = argc > 2 ? std::atoll(argv[2]) : 1000000000;
+    uint32_t same_set_percent = argc > 3 ? std::atoi(argv[3]) : 50;
+
+    // One operation: two vertices and whether it is a query.
+    auto operation = [&](uint64_t i, uint32_t& u, uint32_t& v) {
+        Edge_Random random(42, i);
+        u = uint32_t(random.below(vertices));
+        v = uint32_t(random.below(vertices));
+        return random.below(100) < same_set_percent;
+    };
+
+    Union_Find expected(vertices);
+    uint64_t same_answers = 0;
+    double seconds = measure([&]() {
+        for (uint64_t i = 0; i < operations; i++)
+        {
+            uint32_t u, v;
+            if (operation(i, u, v)) { same_answers += expected.find(u) == expected.find(v); }
+            else { expected.unite(u, v); }
+        }
+    });
+    std::cout << "Sequential union-find:\t" << seconds << " s\t" << operations / seconds / 1e6 << " M operations/s\tsame_set true: " << same_answers << std::endl;
+
+    double single_thread = 0;
+    int max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int threads = 1; ; threads = std::min(threads * 2, max_threads))
+    {
+        Thread_Pool pool(threads);
+        Concurrent_Union_Find sets(vertices);
+        struct alignas(64) Counter { uint64_t joined = 0; }; // One cache line per thread.
+        std::vector<Counter> counters(threads);
+        seconds = measure([&]() {
+            pool.parallel_for(0, operations, [&](uint64_t i, int thread) {
+                uint32_t u, v;
+                if (operation(i, u, v)) { sets.same_set(u, v); }
+                else { counters[thread].joined += sets.unite(u, v); }
+            }, 1 << 16);
+        });
+        if (threads == 1) { single_thread = seconds; }
+
+        // Same partition: every sequential set lies inside one concurrent set, and there are as many sets.
+        bool correct = true;
+        for (uint32_t v = 0; v < vertices; v++) { correct &= sets.same_set(v, expected.find(v)); }
+        uint64_t unions = 0, roots = 0, expected_roots = 0;
+        for (const Counter& counter : counters) { unions += counter.joined; }
+        for (uint32_t v = 0; v < vertices; v++) { roots += sets.is_root(v); expected_roots += expected.find(v) == v; }
+        correct &= roots == expected_roots && unions == vertices - roots;
+        std::cout << "Concurrent, " << threads << " threads:\t" << seconds << " s\t" << operations / seconds / 1e6 << " M operations/s"
+                  << "\tspeedup: " << single_thread / seconds << (correct ? "" : "\tMISMATCH") << std::endl;
+        if (threads == max_threads) { break; }
+    }
+    return 0;
+}